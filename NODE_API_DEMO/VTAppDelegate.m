@@ -21,19 +21,94 @@
 //  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #import "VTAppDelegate.h"
+#import "VTBenchmarkSuite.h"
+#import "VTMemoryAccountant.h"
+
+// Bytes the app's subsystems may buffer before they are asked to trim (override with VTMemoryBudget)
+#define VT_APP_MEMORY_BUDGET    (24 * 1024 * 1024)
+
+@interface VTAppDelegate ()
+@property (strong, nonatomic) VTBenchmarkSuite *benchmarks;
+@end
 
 @implementation VTAppDelegate
 
 @synthesize window = _window;
+@synthesize benchmarks = _benchmarks;
 
 - (BOOL)application:(UIApplication *)application didFinishLaunchingWithOptions:(NSDictionary *)launchOptions
 {
     // Hide the Status bar
     [[UIApplication sharedApplication] setStatusBarHidden:YES];
+
+    // Bounded-memory mode, so unattended sessions can run for days. -VTMemoryBudget 0 turns it off.
+    NSUInteger budget = VT_APP_MEMORY_BUDGET;
+    if ([[NSUserDefaults standardUserDefaults] objectForKey:@"VTMemoryBudget"]) {
+        budget = (NSUInteger)[[NSUserDefaults standardUserDefaults] integerForKey:@"VTMemoryBudget"];
+    }
+    if (budget) {
+        VTMemoryAccountant *accountant = [VTMemoryAccountant sharedInstance];
+        accountant.budget = budget;
+        [accountant start];
+    }
+
+    // Launched with -VTRunBenchmarks YES: run the benchmark suite instead of waiting for the user
+    if ([[NSUserDefaults standardUserDefaults] boolForKey:@"VTRunBenchmarks"]) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self runBenchmarks];
+        });
+    }
     
     return YES;
 }
 
+// Writes Documents/benchmark.json and compares it with Documents/benchmark-baseline.json (or one
+// bundled with the app). Exits with status 1 if any metric regressed by more than
+// VTBenchmarkThreshold (default 0.1), if a check failed, or if there is no baseline, so the run can
+// gate a build. With VTBenchmarkRecordBaseline set, the report becomes the baseline instead.
+- (void)runBenchmarks
+{
+    self.benchmarks = [[VTBenchmarkSuite alloc] init];
+    [self.benchmarks runWithCompletion:^(NSDictionary *report) {
+        NSString *documents = [NSSearchPathForDirectoriesInDomains(NSDocumentDirectory, NSUserDomainMask, YES) objectAtIndex:0];
+        NSString *reportPath = [documents stringByAppendingPathComponent:@"benchmark.json"];
+        [[VTBenchmarkSuite JSONDataForReport:report] writeToFile:reportPath atomically:YES];
+        NSLog(@"Benchmark report written to %@", reportPath);
+
+        NSString *baselinePath = [documents stringByAppendingPathComponent:@"benchmark-baseline.json"];
+        if ([[NSUserDefaults standardUserDefaults] boolForKey:@"VTBenchmarkRecordBaseline"]) {
+            if ([[report objectForKey:VTBenchmarkReportFailuresKey] count]) {
+                NSLog(@"Benchmarks FAILED: not recording a baseline while checks fail");
+                exit(1);
+            }
+            BOOL written = [[VTBenchmarkSuite JSONDataForReport:report] writeToFile:baselinePath atomically:YES];
+            NSLog(@"Benchmark baseline %@ %@", written ? @"written to" : @"could not be written to", baselinePath);
+            exit(written ? 0 : 1);
+        }
+
+        NSDictionary *baseline = [VTBenchmarkSuite reportWithContentsOfFile:baselinePath];
+        if (baseline == nil) {
+            baseline = [VTBenchmarkSuite reportWithContentsOfFile:[[NSBundle mainBundle] pathForResource:@"benchmark-baseline" ofType:@"json"]];
+        }
+        if (baseline == nil) {
+            // Without a baseline the gate would pass anything
+            NSLog(@"Benchmarks FAILED: no baseline; record one on this device with -VTBenchmarkRecordBaseline YES");
+            exit(1);
+        }
+
+        double threshold = 0.1;
+        if ([[NSUserDefaults standardUserDefaults] objectForKey:@"VTBenchmarkThreshold"]) {
+            threshold = [[NSUserDefaults standardUserDefaults] doubleForKey:@"VTBenchmarkThreshold"];
+        }
+        NSArray *regressions = [VTBenchmarkSuite regressionsInReport:report baseline:baseline threshold:threshold];
+        for (NSString *regression in regressions) {
+            NSLog(@"Benchmark regression: %@", regression);
+        }
+        NSLog(@"Benchmarks %@ (%lu regressions past %.0f%%)", [regressions count] ? @"FAILED" : @"passed", (unsigned long)[regressions count], threshold * 100);
+        exit([regressions count] ? 1 : 0);
+    }];
+}
+
 - (void)applicationWillResignActive:(UIApplication *)application
 {
     // Sent when the application is about to move from active to inactive state. This can occur for certain types of temporary interruptions (such as an incoming phone call or SMS message) or when the user quits the application and it begins the transition to the background state.
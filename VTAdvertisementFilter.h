@@ -0,0 +1,111 @@
+//
+//  VTAdvertisementFilter.h
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "VTMemoryAccountant.h"
+
+/** Presence transitions reported by VTAdvertisementFilter */
+typedef enum {
+    /** An advertiser was seen for the first time, or again after being lost */
+    VTPresenceAppeared = 0,
+    /** The smoothed signal strength rose by at least proximityStep dB */
+    VTPresenceMovedCloser,
+    /** The smoothed signal strength fell by at least proximityStep dB */
+    VTPresenceMovedAway,
+    /** Nothing was heard from the advertiser for lostTimeout seconds */
+    VTPresenceLost
+} VTPresenceTransition;
+
+////////////////////////////////////////////////////////////////////////////////
+/** A presence transition for one advertiser */
+@interface VTPresenceEvent : NSObject
+/** The advertiser's identifier */
+@property (readonly, nonatomic) NSString *identifier;
+/** The transition */
+@property (readonly, nonatomic) VTPresenceTransition transition;
+/** The smoothed signal strength in dBm (NAN if unknown) */
+@property (readonly, nonatomic) float rssi;
+/** When the transition happened */
+@property (readonly, nonatomic) NSTimeInterval timestamp;
+/** Whatever object was passed with the advertisement that caused the event (e.g. a VTNodeDevice) */
+@property (readonly, nonatomic) id context;
+@end
+
+/** Block invoked with each presence transition */
+typedef void (^VTPresenceHandler)(VTPresenceEvent *event);
+
+////////////////////////////////////////////////////////////////////////////////
+/** Turns a raw stream of advertisements into a small number of presence transitions.
+
+ Repeated advertisements from the same identifier within duplicateWindow seconds are suppressed
+ after a single dictionary lookup. Accepted advertisements update an exponentially smoothed RSSI
+ and drive a present/absent state machine, so a nearby crowd of advertisers only produces events
+ when something actually changes.
+
+ The filter takes explicit timestamps and never reads the clock itself, so it can be driven by
+ recorded or synthetic advertisement traces. The context of an advertiser is released once it has
+ been reported lost; trimMemory forgets every advertiser that is not present.
+ */
+@interface VTAdvertisementFilter : NSObject <VTMemoryAccounting>
+
+/** Invoked with every presence transition */
+@property (copy, nonatomic) VTPresenceHandler handler;
+/** Advertisements from the same identifier closer together than this are dropped (default 1s) */
+@property (nonatomic) NSTimeInterval duplicateWindow;
+/** Seconds without an advertisement before an advertiser is lost (default 30s) */
+@property (nonatomic) NSTimeInterval lostTimeout;
+/** Weight of each new RSSI value in the smoothed value, 0-1 (default 0.25) */
+@property (nonatomic) float rssiSmoothing;
+/** Change in smoothed RSSI, in dB, reported as moving closer or away (default 8) */
+@property (nonatomic) float proximityStep;
+/** Maximum number of advertisers tracked; the least recently heard are forgotten first (default 512) */
+@property (nonatomic) NSUInteger capacity;
+
+/** Number of advertisers currently tracked, present or not */
+@property (readonly, nonatomic) NSUInteger trackedCount;
+/** Number of advertisers currently present */
+@property (readonly, nonatomic) NSUInteger presentCount;
+/** Number of advertisements accepted */
+@property (readonly, nonatomic) unsigned long long acceptedCount;
+/** Number of advertisements suppressed as duplicates */
+@property (readonly, nonatomic) unsigned long long suppressedCount;
+
+/** Feeds one advertisement into the filter
+
+ @param identifier A stable identifier for the advertiser
+ @param rssi The received signal strength in dBm, or NAN if unknown
+ @param timestamp When the advertisement was received, in seconds
+ @param context An object passed back in any resulting event
+ */
+-(void) observeAdvertisementFrom:(NSString *)identifier rssi:(float)rssi timestamp:(NSTimeInterval)timestamp context:(id)context;
+
+/** Reports any advertisers that have not been heard from within lostTimeout
+
+ Call this periodically (e.g. at the end of each scan window).
+
+ @param timestamp The current time, on the same clock as observeAdvertisementFrom:
+ */
+-(void) expireAt:(NSTimeInterval)timestamp;
+
+/** Forgets every advertiser without reporting them lost */
+-(void) reset;
+@end
@@ -0,0 +1,238 @@
+//
+//  VTAdvertisementFilter.m
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "VTAdvertisementFilter.h"
+#import <objc/runtime.h>
+#include <math.h>
+
+@interface VTPresenceEvent ()
+@property (readwrite, nonatomic) NSString *identifier;
+@property (readwrite, nonatomic) VTPresenceTransition transition;
+@property (readwrite, nonatomic) float rssi;
+@property (readwrite, nonatomic) NSTimeInterval timestamp;
+@property (readwrite, nonatomic) id context;
+@end
+
+@implementation VTPresenceEvent
+@synthesize identifier, transition, rssi, timestamp, context;
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+// Per-advertiser state
+@interface VTAdvertiserRecord : NSObject
+{
+@public
+    NSTimeInterval lastSeen;
+    NSTimeInterval lastAccepted;
+    float smoothedRssi;
+    // Smoothed RSSI at the last reported transition
+    float referenceRssi;
+    BOOL present;
+}
+@property (strong, nonatomic) id context;
+@end
+
+@implementation VTAdvertiserRecord
+@synthesize context;
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+@interface VTAdvertisementFilter ()
+{
+    NSMutableDictionary *records;
+}
+@property (readwrite, nonatomic) NSUInteger presentCount;
+@property (readwrite, nonatomic) unsigned long long acceptedCount;
+@property (readwrite, nonatomic) unsigned long long suppressedCount;
+@end
+
+@implementation VTAdvertisementFilter
+
+@synthesize handler;
+@synthesize duplicateWindow;
+@synthesize lostTimeout;
+@synthesize rssiSmoothing;
+@synthesize proximityStep;
+@synthesize capacity;
+@synthesize presentCount;
+@synthesize acceptedCount;
+@synthesize suppressedCount;
+
+-(id) init
+{
+    self = [super init];
+    if (self) {
+        duplicateWindow = 1.0;
+        lostTimeout = 30.0;
+        rssiSmoothing = 0.25f;
+        proximityStep = 8.0f;
+        capacity = 512;
+        records = [[NSMutableDictionary alloc] init];
+    }
+    return self;
+}
+
+-(NSUInteger) trackedCount
+{
+    return [records count];
+}
+
+#pragma mark - Memory Accounting
+-(NSUInteger) memoryBytesUsed
+{
+    // Record, identifier and a dictionary slot per advertiser
+    return [records count] * (class_getInstanceSize([VTAdvertiserRecord class]) + 64);
+}
+
+-(void) trimMemory
+{
+    NSSet *absent = [records keysOfEntriesPassingTest:^BOOL(NSString *identifier, VTAdvertiserRecord *record, BOOL *stop) {
+        return !record->present;
+    }];
+    [records removeObjectsForKeys:[absent allObjects]];
+}
+
+-(void) reset
+{
+    [records removeAllObjects];
+    self.presentCount = 0;
+}
+
+-(void) report:(VTPresenceTransition)transition identifier:(NSString *)identifier record:(VTAdvertiserRecord *)record timestamp:(NSTimeInterval)timestamp
+{
+    record->referenceRssi = record->smoothedRssi;
+    if (self.handler == nil) {
+        return;
+    }
+
+    VTPresenceEvent *event = [[VTPresenceEvent alloc] init];
+    event.identifier = identifier;
+    event.transition = transition;
+    event.rssi = record->smoothedRssi;
+    event.timestamp = timestamp;
+    event.context = record.context;
+    self.handler(event);
+}
+
+-(void) observeAdvertisementFrom:(NSString *)identifier rssi:(float)rssi timestamp:(NSTimeInterval)timestamp context:(id)context
+{
+    VTAdvertiserRecord *record = [records objectForKey:identifier];
+
+    if (record && timestamp - record->lastAccepted < duplicateWindow) {
+        record->lastSeen = timestamp;
+        self.suppressedCount++;
+        return;
+    }
+    self.acceptedCount++;
+
+    if (record == nil) {
+        if ([records count] >= capacity) {
+            [self evictOldestAt:timestamp];
+        }
+        record = [[VTAdvertiserRecord alloc] init];
+        record->smoothedRssi = NAN;
+        [records setObject:record forKey:identifier];
+    }
+
+    record->lastSeen = timestamp;
+    record->lastAccepted = timestamp;
+    if (context) {
+        record.context = context;
+    }
+
+    if (!isnan(rssi)) {
+        record->smoothedRssi = isnan(record->smoothedRssi) ? rssi : record->smoothedRssi + rssiSmoothing * (rssi - record->smoothedRssi);
+    }
+
+    if (!record->present) {
+        record->present = YES;
+        self.presentCount++;
+        [self report:VTPresenceAppeared identifier:identifier record:record timestamp:timestamp];
+        return;
+    }
+
+    if (isnan(record->referenceRssi)) {
+        record->referenceRssi = record->smoothedRssi;
+    }
+    else if (record->smoothedRssi - record->referenceRssi >= proximityStep) {
+        [self report:VTPresenceMovedCloser identifier:identifier record:record timestamp:timestamp];
+    }
+    else if (record->referenceRssi - record->smoothedRssi >= proximityStep) {
+        [self report:VTPresenceMovedAway identifier:identifier record:record timestamp:timestamp];
+    }
+}
+
+-(void) expireAt:(NSTimeInterval)timestamp
+{
+    NSMutableArray *lost = [[NSMutableArray alloc] init];
+    NSMutableArray *forgotten = [[NSMutableArray alloc] init];
+
+    [records enumerateKeysAndObjectsUsingBlock:^(NSString *identifier, VTAdvertiserRecord *record, BOOL *stop) {
+        NSTimeInterval silent = timestamp - record->lastSeen;
+        if (record->present && silent >= lostTimeout) {
+            record->present = NO;
+            self.presentCount--;
+            [lost addObject:identifier];
+        }
+        if (!record->present && silent >= 4 * lostTimeout) {
+            // Long gone; stop tracking so memory stays proportional to what is nearby
+            [forgotten addObject:identifier];
+        }
+    }];
+
+    // Report outside the enumeration, since the handler may reset or trim the filter
+    NSArray *lostRecords = [records objectsForKeys:lost notFoundMarker:[NSNull null]];
+    [records removeObjectsForKeys:forgotten];
+
+    [lost enumerateObjectsUsingBlock:^(NSString *identifier, NSUInteger idx, BOOL *stop) {
+        VTAdvertiserRecord *record = [lostRecords objectAtIndex:idx];
+        [self report:VTPresenceLost identifier:identifier record:record timestamp:timestamp];
+        // Don't keep the advertiser's device object alive while it is away
+        record.context = nil;
+    }];
+}
+
+// Makes room for a new advertiser by dropping the one heard from least recently
+-(void) evictOldestAt:(NSTimeInterval)timestamp
+{
+    __block NSString *oldestID = nil;
+    __block NSTimeInterval oldestSeen = INFINITY;
+    [records enumerateKeysAndObjectsUsingBlock:^(NSString *identifier, VTAdvertiserRecord *record, BOOL *stop) {
+        if (record->lastSeen < oldestSeen) {
+            oldestSeen = record->lastSeen;
+            oldestID = identifier;
+        }
+    }];
+    if (oldestID == nil) {
+        return;
+    }
+
+    VTAdvertiserRecord *record = [records objectForKey:oldestID];
+    if (record->present) {
+        record->present = NO;
+        self.presentCount--;
+        [self report:VTPresenceLost identifier:oldestID record:record timestamp:timestamp];
+    }
+    [records removeObjectForKey:oldestID];
+}
+
+@end
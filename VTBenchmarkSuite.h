@@ -0,0 +1,106 @@
+//
+//  VTBenchmarkSuite.h
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+
+/** Report keys */
+extern NSString * const VTBenchmarkReportMetricsKey;
+extern NSString * const VTBenchmarkMetricValueKey;
+extern NSString * const VTBenchmarkMetricUnitKey;
+/** "lower" or "higher" */
+extern NSString * const VTBenchmarkMetricBetterKey;
+/** Descriptions of the fixture checks that failed */
+extern NSString * const VTBenchmarkReportFailuresKey;
+
+////////////////////////////////////////////////////////////////////////////////
+/** Measures the host-side pipeline against simulated Nodes, without any hardware.
+
+ Simulated devices feed synthetic readings into a private VTNodeDeviceHub (never the shared one)
+ through the same NodeDeviceDelegate callbacks a VTNodeDevice would use. The suite measures:
+
+ - decode: VTSensorStreamDecoder readings decoded per second
+ - dispatch: cost of forwarding one callback to four classic delegates through the hub, against a
+   generic respondsToSelector: loop over the same delegates, and the ratio of the two
+ - ingest: cost of one callback becoming a sample delivered to a subscriber in a batch
+ - alloc: heap blocks still allocated per ingested sample while its batch is alive
+ - latency: time from a sample entering the hub (with injectSample:, which queues it exactly as a
+   reading callback does) to the subscriber's handler on the main queue, at Kore rate from eight
+   devices
+ - commands: VTStreamConfiguration applications per second, against a recording stand-in (the
+   byte encoding itself happens inside libNode)
+ - scaling: ingest cost per sample through a VTCalibrationStage with 1 to 64 devices
+
+ Before measuring, the suite replays fixed inputs through components and checks their results:
+
+ - gap: a VTStreamGapStage reports no loss from lossless Kore streams delivered in bursts at BLE
+   connection intervals of 7.5 to 45ms, and the right loss when every 20th sample is dropped
+ - timeSeries: a VTTimeSeriesStore fed a simulated week of 1Hz Clima temperature stays within its
+   memory bound and summarizes whole and partial ranges exactly; its cost per value and memory
+   are also reported as metrics
+ - gesture: a VTGestureRecognizer counts the steps of a simulated walk and run, recognizes each
+   activity, and reports turns of a still device by their angle while ignoring turns below its
+   threshold; samples recognized per second on one core and step accuracy are also reported
+
+ Synchronous measurements are repeated and the best run is kept. The report is a JSON-compatible
+ dictionary: metrics maps each metric name to its value, unit and which direction is better, and
+ failures lists the checks that failed.
+ Use it from the main thread, with nothing else running on the main queue for best results.
+ */
+@interface VTBenchmarkSuite : NSObject
+
+/** Times each synchronous measurement is repeated (default 5) */
+@property (nonatomic) NSUInteger repetitions;
+/** Seconds the latency measurement feeds samples for (default 2) */
+@property (nonatomic) NSTimeInterval latencyDuration;
+
+/** Runs every measurement. Most run immediately; the latency measurement needs the main queue, so
+ completion is invoked later.
+
+ @param completion Invoked on the main thread with the report
+ */
+-(void) runWithCompletion:(void (^)(NSDictionary *report))completion;
+
+/** Compares a report with a stored baseline
+
+ Metrics missing from either report are ignored. Failed checks are always included.
+
+ @param report A report produced by runWithCompletion:
+ @param baseline An earlier report
+ @param threshold The allowed relative change in the worse direction, e.g. 0.1 for 10%
+ @return A description of each metric that regressed past threshold (empty if none did)
+ */
++(NSArray *) regressionsInReport:(NSDictionary *)report baseline:(NSDictionary *)baseline threshold:(double)threshold;
+
+/** Serializes a report as pretty-printed JSON
+
+ @param report The report
+ @return The JSON data
+ */
++(NSData *) JSONDataForReport:(NSDictionary *)report;
+
+/** Reads a report written with JSONDataForReport:
+
+ @param path The file to read
+ @return The report, or nil if the file is missing or malformed
+ */
++(NSDictionary *) reportWithContentsOfFile:(NSString *)path;
+@end
@@ -0,0 +1,734 @@
+//
+//  VTBenchmarkSuite.m
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "VTBenchmarkSuite.h"
+#import "VTNodeDeviceHub.h"
+#import "VTSensorStreamCodec.h"
+#import "VTStreamConfiguration.h"
+#import "VTCalibrationStage.h"
+#import "VTStreamGapStage.h"
+#import "VTTimeSeriesStore.h"
+#import "VTGestureRecognizer.h"
+#include <malloc/malloc.h>
+#include <sys/sysctl.h>
+#include <math.h>
+
+NSString * const VTBenchmarkReportMetricsKey = @"metrics";
+NSString * const VTBenchmarkMetricValueKey = @"value";
+NSString * const VTBenchmarkMetricUnitKey = @"unit";
+NSString * const VTBenchmarkMetricBetterKey = @"better";
+NSString * const VTBenchmarkReportFailuresKey = @"failures";
+
+#define VT_BENCH_CHUNK              256
+#define VT_BENCH_CHUNKS             64
+#define VT_BENCH_BATCHES            1000
+#define VT_BENCH_SCALING_SAMPLES    32768
+#define VT_BENCH_LATENCY_STREAMS    8
+#define VT_BENCH_KORE_PERIOD        0.02
+#define VT_BENCH_GAP_SAMPLES        3000
+#define VT_BENCH_WEEK               (7 * 24 * 3600)
+#define VT_BENCH_GAIT_SECONDS       60
+
+static NSUInteger VTBenchmarkBlocksInUse(void)
+{
+    malloc_statistics_t stats;
+    malloc_zone_statistics(NULL, &stats);
+    return stats.blocks_in_use;
+}
+
+static int VTBenchmarkCompareDoubles(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+// A reading on a slow circle, so every sample differs
+static void VTBenchmarkSignal(NSUInteger i, float *v)
+{
+    float t = i * 0.02f;
+    v[0] = sinf(t);
+    v[1] = cosf(t);
+    v[2] = 0.5f * sinf(0.3f * t);
+}
+
+// Repeatable noise in [-0.5, 0.5) for sample i of stream k
+static float VTBenchmarkNoise(NSUInteger i, NSUInteger k)
+{
+    return (float)((i * 7919 + k * 104729) % 1000) / 1000.0f - 0.5f;
+}
+
+// A Clima temperature in degrees C: a daily cycle plus a ten minute sawtooth
+static float VTBenchmarkTemperature(NSUInteger second)
+{
+    return 20.0f + 5.0f * sinf((float)(second % 86400) * (float)(2 * M_PI / 86400)) + (float)(second % 600) * 0.001f;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// A classic hub delegate that only counts what it receives
+@interface VTBenchmarkDelegate : NSObject <NodeDeviceDelegate>
+@property (nonatomic) NSUInteger received;
+@end
+
+@implementation VTBenchmarkDelegate
+
+@synthesize received;
+
+-(void) nodeDeviceDidUpdateAccReading:(VTNodeDevice *)device withReading:(VTSensorReading *)reading
+{
+    received++;
+}
+
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+// Stands in for a VTNodeDevice when applying configurations, counting the commands it is sent
+@interface VTBenchmarkCommandSink : NSObject
+@property (nonatomic) NSUInteger commands;
+@end
+
+@implementation VTBenchmarkCommandSink
+
+@synthesize commands;
+
+-(void) setStreamModeAcc:(bool)aMode Gyro:(bool)gMode Mag:(bool)mMode withPeriod:(uint16_t)p withLifetime:(uint16_t)life { commands++; }
+-(void) setStreamModeOriYpr:(bool)yprMode QuatMode:(bool)qMode { commands++; }
+-(void) setStreamModeClimaTP:(bool)tempPressureMode Humidity:(bool)humidityMode LightProximity:(bool)lpMode withPeriod:(uint16_t)p withLifetime:(uint16_t)life { commands++; }
+-(void) setStreamModeIRThermo:(bool)irMode withLedPower:(bool)ledMode withPeriod:(uint16_t)p withLifetime:(uint16_t)life { commands++; }
+-(void) setStreamModeOxa:(bool)oxaMode withPeriod:(uint16_t)p withLifetime:(uint16_t)life { commands++; }
+-(void) setLumaMode:(unsigned char)mode { commands++; }
+-(void) setLedABlue:(uint8_t)aBluePwr BBlue:(uint8_t)bBluePwr ARed:(uint8_t)aRedPwr BRed:(uint8_t)bRedPwr { commands++; }
+
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+@interface VTBenchmarkSuite ()
+{
+    NSMutableDictionary *metrics;
+    NSMutableArray *failures;
+
+    // Latency run
+    VTNodeDeviceHub *latencyHub;
+    VTHubSubscription *latencySubscription;
+    dispatch_source_t latencyTimer;
+    double *latencies;
+    NSUInteger latencyCount;
+    NSUInteger latencyCapacity;
+    NSUInteger latencyTick;
+}
+@property (copy, nonatomic) void (^completion)(NSDictionary *report);
+@end
+
+@implementation VTBenchmarkSuite
+
+@synthesize repetitions;
+@synthesize latencyDuration;
+@synthesize completion;
+
+-(id) init
+{
+    self = [super init];
+    if (self) {
+        repetitions = 5;
+        latencyDuration = 2.0;
+    }
+    return self;
+}
+
+-(void) dealloc
+{
+    free(latencies);
+}
+
+-(void) setMetric:(NSString *)name value:(double)value unit:(NSString *)unit lowerIsBetter:(BOOL)lowerIsBetter
+{
+    [metrics setObject:[NSDictionary dictionaryWithObjectsAndKeys:
+                        [NSNumber numberWithDouble:isfinite(value) ? value : 0], VTBenchmarkMetricValueKey,
+                        unit, VTBenchmarkMetricUnitKey,
+                        lowerIsBetter ? @"lower" : @"higher", VTBenchmarkMetricBetterKey, nil]
+                forKey:name];
+}
+
+// Records a fixture check that did not produce the expected result
+-(void) check:(BOOL)passed name:(NSString *)name detail:(NSString *)detail
+{
+    if (!passed) {
+        NSLog(@"Benchmark check %@ failed: %@", name, detail);
+        [failures addObject:[NSString stringWithFormat:@"%@: %@", name, detail]];
+    }
+}
+
+// Runs a measurement repetitions times and returns the shortest duration
+-(double) bestOf:(double (^)(void))run
+{
+    double best = INFINITY;
+    for (NSUInteger r = 0; r < MAX(repetitions, 1); r++) {
+        @autoreleasepool {
+            best = MIN(best, run());
+        }
+    }
+    return best;
+}
+
+#pragma mark - Running
+-(void) runWithCompletion:(void (^)(NSDictionary *report))aCompletion
+{
+    self.completion = aCompletion;
+    metrics = [[NSMutableDictionary alloc] init];
+    failures = [[NSMutableArray alloc] init];
+
+    [self checkGapStage];
+    [self checkTimeSeries];
+    [self checkGestures];
+    [self measureDecode];
+    [self measureDispatch];
+    [self measureIngest];
+    [self measureAllocations];
+    [self measureCommands];
+    [self measureScaling];
+    [self startLatency];
+}
+
+-(void) finish
+{
+    char machine[64] = "";
+    size_t size = sizeof(machine);
+    sysctlbyname("hw.machine", machine, &size, NULL, 0);
+
+    NSDateFormatter *formatter = [[NSDateFormatter alloc] init];
+    formatter.locale = [[NSLocale alloc] initWithLocaleIdentifier:@"en_US_POSIX"];
+    formatter.dateFormat = @"yyyy-MM-dd'T'HH:mm:ssZ";
+
+    NSDictionary *report = [NSDictionary dictionaryWithObjectsAndKeys:
+                            [NSNumber numberWithInt:1], @"version",
+                            [formatter stringFromDate:[NSDate date]], @"date",
+                            [NSString stringWithUTF8String:machine], @"machine",
+                            [[NSProcessInfo processInfo] operatingSystemVersionString], @"system",
+                            [metrics copy], VTBenchmarkReportMetricsKey,
+                            [failures copy], VTBenchmarkReportFailuresKey, nil];
+
+    void (^done)(NSDictionary *) = self.completion;
+    self.completion = nil;
+    if (done) {
+        done(report);
+    }
+}
+
+#pragma mark - Measurements
+-(void) measureDecode
+{
+    NSMutableArray *chunks = [[NSMutableArray alloc] init];
+    VTSensorStreamEncoder *encoder = [[VTSensorStreamEncoder alloc] initWithChunkCapacity:VT_BENCH_CHUNK resolution:0.001f];
+    encoder.chunkHandler = ^(NSData *chunk) {
+        [chunks addObject:chunk];
+    };
+    for (NSUInteger i = 0; i < VT_BENCH_CHUNK * VT_BENCH_CHUNKS; i++) {
+        float v[3];
+        VTBenchmarkSignal(i, v);
+        [encoder appendX:v[0] y:v[1] z:v[2]];
+    }
+    [encoder flush];
+
+    float x[VT_BENCH_CHUNK], y[VT_BENCH_CHUNK], z[VT_BENCH_CHUNK];
+    __block NSInteger decoded = 0;
+    double seconds = [self bestOf:^double{
+        decoded = 0;
+        CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+        for (NSData *chunk in chunks) {
+            decoded += [VTSensorStreamDecoder decodeChunk:chunk x:x y:y z:z capacity:VT_BENCH_CHUNK];
+        }
+        return CFAbsoluteTimeGetCurrent() - start;
+    }];
+    [self setMetric:@"decode.readingsPerSecond" value:decoded / seconds unit:@"readings/s" lowerIsBetter:NO];
+}
+
+-(void) measureDispatch
+{
+    VTNodeDeviceHub *hub = [[VTNodeDeviceHub alloc] init];
+    for (int d = 0; d < 4; d++) {
+        [hub addDelegate:[[VTBenchmarkDelegate alloc] init]];
+    }
+    VTSensorReading *reading = [[VTSensorReading alloc] initWithXValue:0 y:1 z:0];
+    const NSUInteger callbacks = VT_BENCH_BATCHES * 64;
+
+    double seconds = [self bestOf:^double{
+        CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+        for (NSUInteger i = 0; i < callbacks; i++) {
+            [hub nodeDeviceDidUpdateAccReading:nil withReading:reading];
+        }
+        return CFAbsoluteTimeGetCurrent() - start;
+    }];
+    [self setMetric:@"dispatch.nsPerCallback" value:seconds * 1e9 / callbacks unit:@"ns" lowerIsBetter:YES];
+
+    // The generic forwarding the hub used before it resolved delegates once: a capability check and a
+    // message send per delegate per callback. The hub's figure also includes its sample bookkeeping,
+    // so the ratio understates the forwarding gain rather than overstating it.
+    NSArray *delegates = [NSArray arrayWithObjects:[[VTBenchmarkDelegate alloc] init], [[VTBenchmarkDelegate alloc] init],
+                          [[VTBenchmarkDelegate alloc] init], [[VTBenchmarkDelegate alloc] init], nil];
+    SEL selector = @selector(nodeDeviceDidUpdateAccReading:withReading:);
+    double genericSeconds = [self bestOf:^double{
+        CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+        for (NSUInteger i = 0; i < callbacks; i++) {
+            for (NSObject<NodeDeviceDelegate> *delegate in delegates) {
+                if ([delegate respondsToSelector:selector]) {
+                    [delegate nodeDeviceDidUpdateAccReading:nil withReading:reading];
+                }
+            }
+        }
+        return CFAbsoluteTimeGetCurrent() - start;
+    }];
+    [self setMetric:@"dispatch.genericNsPerCallback" value:genericSeconds * 1e9 / callbacks unit:@"ns" lowerIsBetter:YES];
+    [self setMetric:@"dispatch.resolvedSpeedup" value:genericSeconds / seconds unit:@"ratio" lowerIsBetter:NO];
+}
+
+// Feeds batches * batchSize acc callbacks into a fresh hub with one subscriber on a private queue.
+// If keep is non-nil, the subscriber keeps every batch in it.
+-(double) ingestBatches:(NSUInteger)batches keep:(NSMutableArray *)keep
+{
+    VTNodeDeviceHub *hub = [[VTNodeDeviceHub alloc] init];
+    // Measure throughput, not the backlog cap
+    hub.maxPendingBatches = 0;
+    dispatch_queue_t queue = dispatch_queue_create("com.variabletech.benchmark.ingest", DISPATCH_QUEUE_SERIAL);
+    VTHubSubscription *subscription = [hub subscribeToChannels:VTSampleChannelMask(VTSampleChannelAcc) queue:queue handler:^(VTSampleBatch *batch) {
+        [keep addObject:batch];
+    }];
+
+    NSMutableArray *readings = [[NSMutableArray alloc] initWithCapacity:hub.batchSize];
+    for (NSUInteger i = 0; i < hub.batchSize; i++) {
+        float v[3];
+        VTBenchmarkSignal(i, v);
+        [readings addObject:[[VTSensorReading alloc] initWithXValue:v[0] y:v[1] z:v[2]]];
+    }
+
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    for (NSUInteger b = 0; b < batches; b++) {
+        for (VTSensorReading *reading in readings) {
+            [hub nodeDeviceDidUpdateAccReading:nil withReading:reading];
+        }
+    }
+    dispatch_sync(queue, ^{});
+    double seconds = CFAbsoluteTimeGetCurrent() - start;
+
+    [hub unsubscribe:subscription];
+    dispatch_release(queue);
+    return seconds;
+}
+
+-(void) measureIngest
+{
+    double seconds = [self bestOf:^double{
+        return [self ingestBatches:VT_BENCH_BATCHES keep:nil];
+    }];
+    [self setMetric:@"ingest.nsPerSample" value:seconds * 1e9 / (VT_BENCH_BATCHES * 64) unit:@"ns" lowerIsBetter:YES];
+}
+
+-(void) measureAllocations
+{
+    // Keep every batch alive so the blocks they hold can be counted
+    NSMutableArray *keep = [[NSMutableArray alloc] initWithCapacity:VT_BENCH_BATCHES];
+    NSUInteger before, after;
+    @autoreleasepool {
+        [self ingestBatches:1 keep:[NSMutableArray array]];
+        before = VTBenchmarkBlocksInUse();
+        [self ingestBatches:VT_BENCH_BATCHES keep:keep];
+    }
+    after = VTBenchmarkBlocksInUse();
+    double perSample = after > before ? (double)(after - before) / (VT_BENCH_BATCHES * 64) : 0;
+    [keep removeAllObjects];
+    [self setMetric:@"alloc.blocksPerSample" value:perSample unit:@"blocks" lowerIsBetter:YES];
+}
+
+-(void) measureCommands
+{
+    VTBenchmarkCommandSink *sink = [[VTBenchmarkCommandSink alloc] init];
+    VTStreamConfiguration *configuration = [[VTStreamConfiguration alloc] init];
+    configuration.koreAcc = configuration.koreGyro = YES;
+    configuration.lumaMode = 0x0f;
+    const NSUInteger applications = 100000;
+
+    double seconds = [self bestOf:^double{
+        sink.commands = 0;
+        CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+        for (NSUInteger i = 0; i < applications; i++) {
+            [configuration applyToDevice:(VTNodeDevice *)sink];
+        }
+        return CFAbsoluteTimeGetCurrent() - start;
+    }];
+    [self setMetric:@"commands.perSecond" value:sink.commands / seconds unit:@"commands/s" lowerIsBetter:NO];
+}
+
+-(void) measureScaling
+{
+    double single = 0;
+    for (NSUInteger devices = 1; devices <= 64; devices *= 2) {
+        // Samples are built up front, so only the hub and stage are timed
+        NSMutableArray *samples = [[NSMutableArray alloc] initWithCapacity:VT_BENCH_SCALING_SAMPLES];
+        NSMutableArray *deviceIDs = [[NSMutableArray alloc] init];
+        for (NSUInteger d = 0; d < devices; d++) {
+            [deviceIDs addObject:[NSString stringWithFormat:@"SIM-%02lu", (unsigned long)d]];
+        }
+        CFAbsoluteTime t0 = CFAbsoluteTimeGetCurrent();
+        for (NSUInteger i = 0; i < VT_BENCH_SCALING_SAMPLES; i++) {
+            float v[3];
+            VTBenchmarkSignal(i / devices, v);
+            VTSampleChannel channel = (i / devices) % 2 ? VTSampleChannelMag : VTSampleChannelGyro;
+            [samples addObject:[[VTNodeSample alloc] initWithDevice:nil deviceID:[deviceIDs objectAtIndex:i % devices] channel:channel
+                                                          timestamp:t0 + (i / devices) * 0.01 flags:VTSampleFlagNone values:v]];
+        }
+
+        double seconds = [self bestOf:^double{
+            VTNodeDeviceHub *hub = [[VTNodeDeviceHub alloc] init];
+            hub.maxPendingBatches = 0;
+            [hub addStage:[[VTCalibrationStage alloc] init]];
+            dispatch_queue_t queue = dispatch_queue_create("com.variabletech.benchmark.scaling", DISPATCH_QUEUE_SERIAL);
+            VTHubSubscription *subscription = [hub subscribeToChannels:VTSampleChannelMaskKore queue:queue handler:^(VTSampleBatch *batch) {}];
+
+            CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+            for (VTNodeSample *sample in samples) {
+                [hub injectSample:sample];
+            }
+            [hub flush];
+            dispatch_sync(queue, ^{});
+            double elapsed = CFAbsoluteTimeGetCurrent() - start;
+
+            [hub unsubscribe:subscription];
+            dispatch_release(queue);
+            return elapsed;
+        }];
+
+        double ns = seconds * 1e9 / VT_BENCH_SCALING_SAMPLES;
+        if (devices == 1) {
+            single = ns;
+        }
+        [self setMetric:[NSString stringWithFormat:@"scaling.nsPerSample.devices%lu", (unsigned long)devices] value:ns unit:@"ns" lowerIsBetter:YES];
+        if (devices == 64) {
+            [self setMetric:@"scaling.efficiency64" value:single / ns unit:@"ratio" lowerIsBetter:NO];
+        }
+    }
+}
+
+#pragma mark - Checks
+// Kore samples every 20ms delivered at BLE connection events, so they arrive in bursts. Returns the
+// samples the stage counted as missing; every dropEvery'th sample is left out (0 for none).
+-(unsigned long long) missingFromGapStage:(VTStreamGapStage *)stage connectionInterval:(NSTimeInterval)connectionInterval dropEvery:(NSUInteger)dropEvery
+{
+    NSMutableArray *samples = [[NSMutableArray alloc] initWithCapacity:VT_BENCH_GAP_SAMPLES];
+    for (NSUInteger i = 0; i < VT_BENCH_GAP_SAMPLES; i++) {
+        if (dropEvery && i % dropEvery == dropEvery - 1) {
+            continue;
+        }
+        float v[3];
+        VTBenchmarkSignal(i, v);
+        // Up to 2ms of delivery jitter on top of waiting for the next connection event
+        NSTimeInterval delivered = ceil(i * VT_BENCH_KORE_PERIOD / connectionInterval) * connectionInterval + (i * 7919 % 1000) * 2e-6;
+        [samples addObject:[[VTNodeSample alloc] initWithDevice:nil deviceID:@"SIM-00" channel:VTSampleChannelAcc
+                                                      timestamp:delivered flags:VTSampleFlagNone values:v]];
+    }
+    [samples sortUsingComparator:^NSComparisonResult(VTNodeSample *a, VTNodeSample *b) {
+        return a.timestamp < b.timestamp ? NSOrderedAscending : (a.timestamp > b.timestamp ? NSOrderedDescending : NSOrderedSame);
+    }];
+
+    // Passed on a connection event at a time, as the hub would
+    for (NSUInteger i = 0; i < [samples count]; i += 4) {
+        [stage stageProcessSamples:[samples subarrayWithRange:NSMakeRange(i, MIN(4, [samples count] - i))] channel:VTSampleChannelAcc];
+    }
+    return [stage statisticsForChannel:VTSampleChannelAcc].missing;
+}
+
+-(void) checkGapStage
+{
+    const NSTimeInterval connectionIntervals[] = { 0.0075, 0.015, 0.03, 0.045 };
+    for (int c = 0; c < 4; c++) {
+        NSTimeInterval connectionInterval = connectionIntervals[c];
+        unsigned long long missing = [self missingFromGapStage:[[VTStreamGapStage alloc] init] connectionInterval:connectionInterval dropEvery:0];
+        [self check:missing == 0 name:[NSString stringWithFormat:@"gap.bursty%.1fms", connectionInterval * 1000]
+             detail:[NSString stringWithFormat:@"%llu samples reported missing from a lossless stream", missing]];
+
+        VTStreamGapStage *stage = [[VTStreamGapStage alloc] init];
+        [stage setExpectedPeriod:VT_BENCH_KORE_PERIOD forChannel:VTSampleChannelAcc];
+        missing = [self missingFromGapStage:stage connectionInterval:connectionInterval dropEvery:20];
+        unsigned long long dropped = VT_BENCH_GAP_SAMPLES / 20;
+        [self check:missing + dropped / 10 >= dropped && missing <= dropped + dropped / 10
+               name:[NSString stringWithFormat:@"gap.burstyLoss%.1fms", connectionInterval * 1000]
+             detail:[NSString stringWithFormat:@"%llu samples reported missing, %llu dropped", missing, dropped]];
+    }
+}
+
+// A week of one temperature reading per second, then summaries compared with the fixture itself
+-(void) checkTimeSeries
+{
+    // Hour-aligned, so whole days are answered from hour buckets
+    const NSTimeInterval t0 = 3600.0 * 100000;
+    __block VTTimeSeriesStore *store = nil;
+    double seconds = [self bestOf:^double{
+        store = [[VTTimeSeriesStore alloc] init];
+        CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+        for (NSUInteger second = 0; second < VT_BENCH_WEEK; second++) {
+            [store addValue:VTBenchmarkTemperature(second) timestamp:t0 + second deviceID:@"SIM-00" channel:VTSampleChannelClimaTemp];
+        }
+        return CFAbsoluteTimeGetCurrent() - start;
+    }];
+    [self setMetric:@"timeSeries.nsPerValue" value:seconds * 1e9 / VT_BENCH_WEEK unit:@"ns" lowerIsBetter:YES];
+    [self setMetric:@"timeSeries.weekBytes" value:store.bytesUsed unit:@"bytes" lowerIsBetter:YES];
+    [self check:store.bytesUsed <= 170 * 1024 name:@"timeSeries.bounded"
+         detail:[NSString stringWithFormat:@"%lu bytes for one channel", (unsigned long)store.bytesUsed]];
+
+    // The whole week and a day from hours, the last 617s from seconds, most of the last day from minutes
+    const NSUInteger ranges[][2] = {
+        { 0, VT_BENCH_WEEK },
+        { 2 * 86400, 3 * 86400 },
+        { VT_BENCH_WEEK - 617, VT_BENCH_WEEK },
+        { VT_BENCH_WEEK - 86400 + 37 * 60, VT_BENCH_WEEK - 5 * 60 }
+    };
+    for (int r = 0; r < 4; r++) {
+        NSUInteger count = 0;
+        double sum = 0;
+        float minimum = INFINITY, maximum = -INFINITY;
+        for (NSUInteger second = ranges[r][0]; second < ranges[r][1]; second++) {
+            float value = VTBenchmarkTemperature(second);
+            count++;
+            sum += value;
+            minimum = MIN(minimum, value);
+            maximum = MAX(maximum, value);
+        }
+        VTSeriesSummary *summary = [store summaryForDeviceID:@"SIM-00" channel:VTSampleChannelClimaTemp from:t0 + ranges[r][0] to:t0 + ranges[r][1]];
+        double mean = sum / count;
+        BOOL exact = summary.count == count && summary.minimum == minimum && summary.maximum == maximum && fabs(summary.mean - mean) <= 1e-6 * fabs(mean);
+        [self check:exact name:[NSString stringWithFormat:@"timeSeries.summary%d", r]
+             detail:[NSString stringWithFormat:@"%@, expected n:%lu min:%.3f max:%.3f mean:%.3f", summary, (unsigned long)count, minimum, maximum, mean]];
+    }
+
+    NSArray *hours = [store seriesForDeviceID:@"SIM-00" channel:VTSampleChannelClimaTemp from:t0 to:t0 + VT_BENCH_WEEK resolution:3600];
+    [self check:[hours count] == VT_BENCH_WEEK / 3600 name:@"timeSeries.hourlySeries"
+         detail:[NSString stringWithFormat:@"%lu hourly buckets for a week", (unsigned long)[hours count]]];
+}
+
+// A Kore session: an accelerometer and a gyroscope sample every 20ms, with a little noise on each axis.
+// The acceleration magnitude is 1g plus a sine at cadence Hz, one step per cycle, and the device turns
+// about z by turns[k] degrees during the third second of every four.
+-(NSArray *) gestureTraceForDeviceID:(NSString *)deviceID seconds:(NSUInteger)seconds cadence:(float)cadence amplitude:(float)amplitude turns:(const float *)turns count:(NSUInteger)turnCount
+{
+    NSUInteger perSecond = (NSUInteger)round(1 / VT_BENCH_KORE_PERIOD);
+    NSMutableArray *samples = [[NSMutableArray alloc] initWithCapacity:2 * seconds * perSecond];
+    for (NSUInteger i = 0; i < seconds * perSecond; i++) {
+        NSTimeInterval t = i * VT_BENCH_KORE_PERIOD;
+        NSUInteger turn = i / (4 * perSecond), phase = i % (4 * perSecond);
+        float rate = (turn < turnCount && phase >= 2 * perSecond && phase < 3 * perSecond) ? turns[turn] : 0;
+        float acc[3] = { 0.01f * VTBenchmarkNoise(i, 1), 0.01f * VTBenchmarkNoise(i, 2),
+                         1.0f + amplitude * sinf((float)(2 * M_PI * cadence * t)) + 0.01f * VTBenchmarkNoise(i, 0) };
+        float gyro[3] = { 2 * VTBenchmarkNoise(i, 3), 2 * VTBenchmarkNoise(i, 4), rate + 2 * VTBenchmarkNoise(i, 5) };
+        [samples addObject:[[VTNodeSample alloc] initWithDevice:nil deviceID:deviceID channel:VTSampleChannelAcc
+                                                      timestamp:t flags:VTSampleFlagNone values:acc]];
+        [samples addObject:[[VTNodeSample alloc] initWithDevice:nil deviceID:deviceID channel:VTSampleChannelGyro
+                                                      timestamp:t flags:VTSampleFlagNone values:gyro]];
+    }
+    return samples;
+}
+
+// A walk, a run and a series of turns through a VTGestureRecognizer, with steps, activity and angles
+// compared with what the traces were built from
+-(void) checkGestures
+{
+    const float cadences[] = { 1.8f, 3.0f };
+    const float amplitudes[] = { 0.3f, 0.8f };
+    const VTActivity activities[] = { VTActivityWalking, VTActivityRunning };
+    // Still between turns; the 45 degree turns are below the default threshold and must not be reported
+    const float turns[] = { 180, -180, 120, -120, 45, -45, 360 };
+    const NSUInteger turnCount = sizeof(turns) / sizeof(turns[0]);
+
+    NSMutableArray *traces = [[NSMutableArray alloc] init];
+    for (int g = 0; g < 2; g++) {
+        [traces addObject:[self gestureTraceForDeviceID:[NSString stringWithFormat:@"SIM-%02d", g] seconds:VT_BENCH_GAIT_SECONDS
+                                                cadence:cadences[g] amplitude:amplitudes[g] turns:NULL count:0]];
+    }
+    [traces addObject:[self gestureTraceForDeviceID:@"SIM-02" seconds:4 * turnCount cadence:0 amplitude:0 turns:turns count:turnCount]];
+
+    NSUInteger sampleCount = 0;
+    for (NSArray *trace in traces) {
+        sampleCount += [trace count];
+    }
+    __block NSArray *results = nil;
+    double seconds = [self bestOf:^double{
+        VTGestureRecognizer *recognizer = [[VTGestureRecognizer alloc] init];
+        NSMutableArray *events = [[NSMutableArray alloc] initWithCapacity:[traces count]];
+        CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+        for (NSArray *trace in traces) {
+            [events addObject:[recognizer recognizeSamples:trace]];
+        }
+        double elapsed = CFAbsoluteTimeGetCurrent() - start;
+        results = events;
+        return elapsed;
+    }];
+    [self setMetric:@"gesture.samplesPerSecond" value:sampleCount / seconds unit:@"samples/s" lowerIsBetter:NO];
+
+    float expectedSteps = 0, stepError = 0;
+    for (int g = 0; g < 2; g++) {
+        float steps = 0;
+        NSUInteger others = 0;
+        VTActivity activity = VTActivityUnknown;
+        for (VTMotionEvent *event in [results objectAtIndex:g]) {
+            if (event.type == VTMotionEventSteps) {
+                steps += event.value;
+            }
+            else if (event.type == VTMotionEventActivityChanged) {
+                activity = event.activity;
+            }
+            else {
+                others++;
+            }
+        }
+        float expected = cadences[g] * VT_BENCH_GAIT_SECONDS;
+        expectedSteps += expected;
+        stepError += fabsf(steps - expected);
+        [self check:fabsf(steps - expected) <= 0.02f * expected && others == 0 && activity == activities[g]
+               name:(g ? @"gesture.running" : @"gesture.walking")
+             detail:[NSString stringWithFormat:@"%.0f of %.0f steps, %lu other events, activity %d", steps, expected, (unsigned long)others, activity]];
+    }
+    [self setMetric:@"gesture.stepAccuracy" value:1 - stepError / expectedSteps unit:@"ratio" lowerIsBetter:NO];
+
+    // Each turn's rotations are attributed by the four seconds they fall in
+    float reported[sizeof(turns) / sizeof(turns[0])] = { 0 };
+    NSUInteger others = 0;
+    for (VTMotionEvent *event in [results objectAtIndex:2]) {
+        if (event.type == VTMotionEventRotation) {
+            reported[MIN((NSUInteger)(event.timestamp / 4), turnCount - 1)] += event.value;
+        }
+        else if (event.type != VTMotionEventActivityChanged) {
+            others++;
+        }
+    }
+    for (NSUInteger k = 0; k < turnCount; k++) {
+        float expected = fabsf(turns[k]) >= 90 ? turns[k] : 0;
+        [self check:fabsf(reported[k] - expected) <= 0.05f * fabsf(turns[k]) name:[NSString stringWithFormat:@"gesture.turn%lu", (unsigned long)k]
+             detail:[NSString stringWithFormat:@"%.1f degrees reported for a %.0f degree turn", reported[k], turns[k]]];
+    }
+    [self check:others == 0 name:@"gesture.turnsOnly"
+         detail:[NSString stringWithFormat:@"%lu taps, shakes or steps while turning in place", (unsigned long)others]];
+}
+
+#pragma mark - Latency
+-(void) startLatency
+{
+    NSUInteger ticks = (NSUInteger)ceil(latencyDuration / VT_BENCH_KORE_PERIOD);
+    latencyCapacity = ticks * VT_BENCH_LATENCY_STREAMS;
+    latencies = realloc(latencies, MAX(latencyCapacity, 1) * sizeof(double));
+    latencyCount = 0;
+    latencyTick = 0;
+
+    latencyHub = [[VTNodeDeviceHub alloc] init];
+    __unsafe_unretained VTBenchmarkSuite *suite = self;
+    latencySubscription = [latencyHub subscribeToChannels:VTSampleChannelMask(VTSampleChannelAcc) queue:NULL handler:^(VTSampleBatch *batch) {
+        CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+        for (VTNodeSample *sample in batch.samples) {
+            if (suite->latencyCount < suite->latencyCapacity) {
+                suite->latencies[suite->latencyCount++] = now - sample.timestamp;
+            }
+        }
+    }];
+
+    // Each stream is its own simulated device, fed the way the hub's callbacks would feed it
+    NSMutableArray *deviceIDs = [[NSMutableArray alloc] initWithCapacity:VT_BENCH_LATENCY_STREAMS];
+    for (int s = 0; s < VT_BENCH_LATENCY_STREAMS; s++) {
+        [deviceIDs addObject:[NSString stringWithFormat:@"SIM-%02d", s]];
+    }
+    latencyTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, dispatch_get_main_queue());
+    dispatch_source_set_timer(latencyTimer, dispatch_time(DISPATCH_TIME_NOW, 0), VT_BENCH_KORE_PERIOD * NSEC_PER_SEC, NSEC_PER_MSEC);
+    dispatch_source_set_event_handler(latencyTimer, ^{
+        if (latencyTick++ == ticks) {
+            [self finishLatency];
+            return;
+        }
+        const float values[3] = { 0, 0, 1 };
+        for (NSString *deviceID in deviceIDs) {
+            [latencyHub injectSample:[[VTNodeSample alloc] initWithDevice:nil deviceID:deviceID channel:VTSampleChannelAcc
+                                                                timestamp:CFAbsoluteTimeGetCurrent() flags:VTSampleFlagNone values:values]];
+        }
+    });
+    dispatch_resume(latencyTimer);
+}
+
+-(void) finishLatency
+{
+    dispatch_source_cancel(latencyTimer);
+    dispatch_release(latencyTimer);
+    latencyTimer = NULL;
+
+    // Let the last flush be delivered before reading the results
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [latencyHub unsubscribe:latencySubscription];
+        latencySubscription = nil;
+        latencyHub = nil;
+
+        qsort(latencies, latencyCount, sizeof(double), VTBenchmarkCompareDoubles);
+        double p50 = latencyCount ? latencies[latencyCount / 2] : 0;
+        double p99 = latencyCount ? latencies[MIN(latencyCount - 1, latencyCount * 99 / 100)] : 0;
+        [self setMetric:@"latency.p50Ms" value:p50 * 1000 unit:@"ms" lowerIsBetter:YES];
+        [self setMetric:@"latency.p99Ms" value:p99 * 1000 unit:@"ms" lowerIsBetter:YES];
+        [self finish];
+    });
+}
+
+#pragma mark - Reports
++(NSArray *) regressionsInReport:(NSDictionary *)report baseline:(NSDictionary *)baseline threshold:(double)threshold
+{
+    NSMutableArray *regressions = [[NSMutableArray alloc] init];
+    for (NSString *failure in [report objectForKey:VTBenchmarkReportFailuresKey]) {
+        [regressions addObject:[NSString stringWithFormat:@"check %@", failure]];
+    }
+    NSDictionary *current = [report objectForKey:VTBenchmarkReportMetricsKey];
+    NSDictionary *previous = [baseline objectForKey:VTBenchmarkReportMetricsKey];
+
+    for (NSString *name in [[current allKeys] sortedArrayUsingSelector:@selector(compare:)]) {
+        NSDictionary *metric = [current objectForKey:name];
+        NSDictionary *base = [previous objectForKey:name];
+        if (base == nil) {
+            continue;
+        }
+        double value = [[metric objectForKey:VTBenchmarkMetricValueKey] doubleValue];
+        double reference = [[base objectForKey:VTBenchmarkMetricValueKey] doubleValue];
+        BOOL lowerIsBetter = [[metric objectForKey:VTBenchmarkMetricBetterKey] isEqualToString:@"lower"];
+
+        BOOL regressed = lowerIsBetter ? value > reference * (1 + threshold) : value < reference * (1 - threshold);
+        if (regressed) {
+            [regressions addObject:[NSString stringWithFormat:@"%@: %.3f %@ (baseline %.3f, %+.1f%%)",
+                                    name, value, [metric objectForKey:VTBenchmarkMetricUnitKey], reference,
+                                    reference != 0 ? (value / reference - 1) * 100 : 0]];
+        }
+    }
+    return regressions;
+}
+
++(NSData *) JSONDataForReport:(NSDictionary *)report
+{
+    return [NSJSONSerialization dataWithJSONObject:report options:NSJSONWritingPrettyPrinted error:NULL];
+}
+
++(NSDictionary *) reportWithContentsOfFile:(NSString *)path
+{
+    NSData *data = [NSData dataWithContentsOfFile:path];
+    if (data == nil) {
+        return nil;
+    }
+    id report = [NSJSONSerialization JSONObjectWithData:data options:0 error:NULL];
+    return [report isKindOfClass:[NSDictionary class]] ? report : nil;
+}
+
+@end
@@ -0,0 +1,98 @@
+//
+//  VTCalibrationStage.h
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "VTNodeDeviceHub.h"
+
+////////////////////////////////////////////////////////////////////////////////
+/** A snapshot of the host-side calibration of one device */
+@interface VTSensorCalibration : NSObject
+/** YES once an ellipsoid fit has succeeded */
+@property (readonly, nonatomic) BOOL hasMagnetic;
+/** YES once at least one still period has been seen */
+@property (readonly, nonatomic) BOOL hasGyroBias;
+/** Magnetometer samples that have contributed to the fit */
+@property (readonly, nonatomic) NSUInteger magneticSamples;
+/** Still gyro windows that have contributed to the bias */
+@property (readonly, nonatomic) NSUInteger stillWindows;
+
+/** Copies the hard-iron offset (the ellipsoid centre) into a buffer of 3 floats */
+-(void) getHardIron:(float *)offset;
+/** Copies the per-axis soft-iron scale into a buffer of 3 floats */
+-(void) getSoftIron:(float *)scale;
+/** Copies the gyro zero-rate bias into a buffer of 3 floats */
+-(void) getGyroBias:(float *)bias;
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+/** A hub stage that calibrates the magnetometer and gyroscope on the host while streaming.
+
+ Magnetometer: every reading that has moved far enough from the last one used is added to the
+ normal equations of an axis-aligned ellipsoid, a x^2 + b y^2 + c z^2 + d x + e y + f z = 1. The 6x6
+ system is re-solved every solveInterval samples; the centre gives the hard-iron offset and the
+ radii give a per-axis soft-iron scale that maps the ellipsoid onto a sphere of the mean radius.
+ Corrections are applied as (m - offset) * scale. Older readings are forgotten exponentially (and the
+ swept extents shrink with them), so the fit follows a device into a new magnetic environment.
+
+ Gyroscope: readings are grouped into windows of stillWindow samples. A window whose per-axis
+ deviation stays under stillThreshold, and whose mean stays under maxBias, is taken as a still
+ period and its mean is folded into the bias estimate, which is then subtracted from every reading.
+
+ Only samples passed through the hub are corrected (they carry VTSampleFlagCalibrated); readings
+ delivered to classic NodeDeviceDelegate callbacks are untouched. Neither solver needs the device to
+ disconnect, unlike requestMagnetometerCalibration and requestGyroscopeCalibration. Add this stage
+ ahead of any stage that consumes calibrated values.
+ */
+@interface VTCalibrationStage : NSObject <VTSampleStage>
+
+/** NO to keep estimating without modifying samples (default YES) */
+@property (nonatomic) BOOL applyCorrections;
+/** Magnetometer samples required before the first fit is accepted (default 100) */
+@property (nonatomic) NSUInteger minMagneticSamples;
+/** Magnetometer samples between re-solves (default 25) */
+@property (nonatomic) NSUInteger solveInterval;
+/** Roughly how many recent magnetometer samples the fit reflects; each new sample weighs older ones
+ down by 1 - 1/magneticMemory. 0 keeps every sample forever. (default 1000) */
+@property (nonatomic) NSUInteger magneticMemory;
+/** Gyro samples per stillness window (default 50) */
+@property (nonatomic) NSUInteger stillWindow;
+/** Largest per-axis gyro deviation, in deg/s, of a still window (default 0.5) */
+@property (nonatomic) float stillThreshold;
+/** Largest plausible bias on any axis in deg/s; stiller windows with a larger mean are slow turns (default 5) */
+@property (nonatomic) float maxBias;
+
+/** Returns the current calibration of a device
+
+ @param deviceID The device identifier (see VTNodeSample deviceID)
+ @return A snapshot, or nil if the device has not been seen
+ */
+-(VTSensorCalibration *) calibrationForDeviceID:(NSString *)deviceID;
+
+/** Discards the calibration of one device, e.g. after it has been moved to a new mount
+
+ @param deviceID The device identifier
+ */
+-(void) resetDeviceID:(NSString *)deviceID;
+
+/** Discards every device's calibration */
+-(void) reset;
+@end
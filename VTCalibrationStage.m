@@ -0,0 +1,408 @@
+//
+//  VTCalibrationStage.m
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "VTCalibrationStage.h"
+#include <math.h>
+
+@interface VTSensorCalibration ()
+{
+@public
+    float hardIron[3];
+    float softIron[3];
+    float gyroBias[3];
+}
+@property (readwrite, nonatomic) BOOL hasMagnetic;
+@property (readwrite, nonatomic) BOOL hasGyroBias;
+@property (readwrite, nonatomic) NSUInteger magneticSamples;
+@property (readwrite, nonatomic) NSUInteger stillWindows;
+@end
+
+@implementation VTSensorCalibration
+
+@synthesize hasMagnetic, hasGyroBias, magneticSamples, stillWindows;
+
+-(id) init
+{
+    self = [super init];
+    if (self) {
+        softIron[0] = softIron[1] = softIron[2] = 1.0f;
+    }
+    return self;
+}
+
+-(void) getHardIron:(float *)offset
+{
+    memcpy(offset, hardIron, sizeof(hardIron));
+}
+
+-(void) getSoftIron:(float *)scale
+{
+    memcpy(scale, softIron, sizeof(softIron));
+}
+
+-(void) getGyroBias:(float *)bias
+{
+    memcpy(bias, gyroBias, sizeof(gyroBias));
+}
+
+-(NSString *) description
+{
+    return [NSString stringWithFormat:@"<%@ hard:(%.2f %.2f %.2f) soft:(%.3f %.3f %.3f) bias:(%.3f %.3f %.3f) samples:%lu still:%lu>",
+            NSStringFromClass([self class]), hardIron[0], hardIron[1], hardIron[2], softIron[0], softIron[1], softIron[2],
+            gyroBias[0], gyroBias[1], gyroBias[2], (unsigned long)magneticSamples, (unsigned long)stillWindows];
+}
+
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+// Solver state for one device
+@interface VTCalibrationTrack : NSObject
+{
+@public
+    // Normal equations of the ellipsoid fit, for [x^2 y^2 z^2 x y z] . p = 1
+    double normal[6][6];
+    double rhs[6];
+    float lastUsed[3];
+    float minimum[3];
+    float maximum[3];
+    NSUInteger sinceSolve;
+
+    // Current stillness window
+    double gyroSum[3];
+    double gyroSumSquares[3];
+    NSUInteger gyroCount;
+}
+@property (strong, nonatomic) VTSensorCalibration *calibration;
+@end
+
+@implementation VTCalibrationTrack
+
+@synthesize calibration;
+
+-(id) init
+{
+    self = [super init];
+    if (self) {
+        calibration = [[VTSensorCalibration alloc] init];
+        for (int a = 0; a < 3; a++) {
+            minimum[a] = INFINITY;
+            maximum[a] = -INFINITY;
+        }
+    }
+    return self;
+}
+
+@end
+
+// Solves the 6x6 system a x = b in place by Gaussian elimination with partial pivoting
+static BOOL VTSolve6(double a[6][6], double b[6], double x[6])
+{
+    for (int col = 0; col < 6; col++) {
+        int pivot = col;
+        for (int row = col + 1; row < 6; row++) {
+            if (fabs(a[row][col]) > fabs(a[pivot][col])) {
+                pivot = row;
+            }
+        }
+        if (fabs(a[pivot][col]) < 1e-12) {
+            return NO;
+        }
+        if (pivot != col) {
+            for (int k = 0; k < 6; k++) {
+                double t = a[col][k]; a[col][k] = a[pivot][k]; a[pivot][k] = t;
+            }
+            double t = b[col]; b[col] = b[pivot]; b[pivot] = t;
+        }
+        for (int row = col + 1; row < 6; row++) {
+            double f = a[row][col] / a[col][col];
+            for (int k = col; k < 6; k++) {
+                a[row][k] -= f * a[col][k];
+            }
+            b[row] -= f * b[col];
+        }
+    }
+    for (int row = 5; row >= 0; row--) {
+        double sum = b[row];
+        for (int k = row + 1; k < 6; k++) {
+            sum -= a[row][k] * x[k];
+        }
+        x[row] = sum / a[row][row];
+    }
+    return YES;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+@interface VTCalibrationStage ()
+{
+    // deviceID -> VTCalibrationTrack
+    NSMutableDictionary *tracks;
+}
+@end
+
+@implementation VTCalibrationStage
+
+@synthesize applyCorrections;
+@synthesize minMagneticSamples;
+@synthesize solveInterval;
+@synthesize magneticMemory;
+@synthesize stillWindow;
+@synthesize stillThreshold;
+@synthesize maxBias;
+
+-(id) init
+{
+    self = [super init];
+    if (self) {
+        applyCorrections = YES;
+        minMagneticSamples = 100;
+        solveInterval = 25;
+        magneticMemory = 1000;
+        stillWindow = 50;
+        stillThreshold = 0.5f;
+        maxBias = 5.0f;
+        tracks = [[NSMutableDictionary alloc] init];
+    }
+    return self;
+}
+
+-(VTSensorCalibration *) calibrationForDeviceID:(NSString *)deviceID
+{
+    VTCalibrationTrack *track = [tracks objectForKey:deviceID];
+    if (track == nil) {
+        return nil;
+    }
+
+    VTSensorCalibration *current = track.calibration;
+    VTSensorCalibration *copy = [[VTSensorCalibration alloc] init];
+    memcpy(copy->hardIron, current->hardIron, sizeof(copy->hardIron));
+    memcpy(copy->softIron, current->softIron, sizeof(copy->softIron));
+    memcpy(copy->gyroBias, current->gyroBias, sizeof(copy->gyroBias));
+    copy.hasMagnetic = current.hasMagnetic;
+    copy.hasGyroBias = current.hasGyroBias;
+    copy.magneticSamples = current.magneticSamples;
+    copy.stillWindows = current.stillWindows;
+    return copy;
+}
+
+-(void) resetDeviceID:(NSString *)deviceID
+{
+    [tracks removeObjectForKey:deviceID];
+}
+
+-(void) reset
+{
+    [tracks removeAllObjects];
+}
+
+#pragma mark - VTSampleStage
+-(uint32_t) stageChannels
+{
+    return VTSampleChannelMask(VTSampleChannelMag) | VTSampleChannelMask(VTSampleChannelGyro);
+}
+
+-(NSArray *) stageProcessSamples:(NSArray *)samples channel:(VTSampleChannel)channel
+{
+    NSMutableArray *output = applyCorrections ? [[NSMutableArray alloc] initWithCapacity:[samples count]] : nil;
+
+    for (VTNodeSample *sample in samples) {
+        VTCalibrationTrack *track = [tracks objectForKey:sample.deviceID];
+        if (track == nil) {
+            track = [[VTCalibrationTrack alloc] init];
+            [tracks setObject:track forKey:sample.deviceID];
+        }
+
+        float v[3];
+        [sample getValues:v];
+        BOOL corrected;
+        if (channel == VTSampleChannelMag) {
+            [self addMagnetic:v track:track];
+            corrected = [self correctMagnetic:v track:track];
+        }
+        else {
+            [self addGyro:v track:track];
+            corrected = [self correctGyro:v track:track];
+        }
+
+        if (output == nil) {
+            continue;
+        }
+        if (!corrected || (sample.flags & VTSampleFlagCalibrated)) {
+            [output addObject:sample];
+            continue;
+        }
+        [output addObject:[[VTNodeSample alloc] initWithDevice:sample.device deviceID:sample.deviceID channel:channel timestamp:sample.timestamp flags:sample.flags | VTSampleFlagCalibrated values:v]];
+    }
+
+    return output ? output : samples;
+}
+
+#pragma mark - Magnetometer
+-(void) addMagnetic:(const float *)m track:(VTCalibrationTrack *)track
+{
+    float span = 0;
+    for (int a = 0; a < 3; a++) {
+        track->minimum[a] = MIN(track->minimum[a], m[a]);
+        track->maximum[a] = MAX(track->maximum[a], m[a]);
+        span = MAX(span, track->maximum[a] - track->minimum[a]);
+    }
+
+    // Skip readings that barely moved, so a device left lying still doesn't swamp the fit
+    float dx = m[0] - track->lastUsed[0], dy = m[1] - track->lastUsed[1], dz = m[2] - track->lastUsed[2];
+    float separation = 0.01f * span;
+    if (track.calibration.magneticSamples > 0 && dx * dx + dy * dy + dz * dz < separation * separation) {
+        return;
+    }
+    memcpy(track->lastUsed, m, sizeof(track->lastUsed));
+
+    // Exponential forgetting: older readings fade so a changed environment takes over the fit
+    double keep = magneticMemory ? 1.0 - 1.0 / magneticMemory : 1.0;
+    if (magneticMemory) {
+        for (int a = 0; a < 3; a++) {
+            track->minimum[a] = MIN(m[a], track->minimum[a] + (float)(1.0 - keep) * (m[a] - track->minimum[a]));
+            track->maximum[a] = MAX(m[a], track->maximum[a] + (float)(1.0 - keep) * (m[a] - track->maximum[a]));
+        }
+    }
+
+    double phi[6] = { (double)m[0] * m[0], (double)m[1] * m[1], (double)m[2] * m[2], m[0], m[1], m[2] };
+    for (int i = 0; i < 6; i++) {
+        for (int j = 0; j < 6; j++) {
+            track->normal[i][j] = keep * track->normal[i][j] + phi[i] * phi[j];
+        }
+        track->rhs[i] = keep * track->rhs[i] + phi[i];
+    }
+    track.calibration.magneticSamples++;
+
+    if (track.calibration.magneticSamples >= minMagneticSamples && ++track->sinceSolve >= solveInterval) {
+        track->sinceSolve = 0;
+        [self solveMagnetic:track];
+    }
+}
+
+-(void) solveMagnetic:(VTCalibrationTrack *)track
+{
+    double lhs[6][6], rhs[6], p[6];
+    memcpy(lhs, track->normal, sizeof(lhs));
+    memcpy(rhs, track->rhs, sizeof(rhs));
+    if (!VTSolve6(lhs, rhs, p)) {
+        return;
+    }
+    if (p[0] <= 0 || p[1] <= 0 || p[2] <= 0) {
+        // Not an ellipsoid yet; the readings don't cover enough orientations
+        return;
+    }
+
+    double centre[3], radius[3];
+    double g = 1.0;
+    for (int a = 0; a < 3; a++) {
+        centre[a] = -p[a + 3] / (2.0 * p[a]);
+        g += p[a] * centre[a] * centre[a];
+    }
+    double meanRadius = 0;
+    for (int a = 0; a < 3; a++) {
+        radius[a] = sqrt(g / p[a]);
+        meanRadius += radius[a] / 3.0;
+    }
+
+    // Require every axis to have swept at least one radius, and a plausible amount of distortion
+    double smallest = MIN(radius[0], MIN(radius[1], radius[2]));
+    double largest = MAX(radius[0], MAX(radius[1], radius[2]));
+    if (largest > 3.0 * smallest) {
+        return;
+    }
+    for (int a = 0; a < 3; a++) {
+        if (track->maximum[a] - track->minimum[a] < radius[a]) {
+            return;
+        }
+    }
+
+    VTSensorCalibration *calibration = track.calibration;
+    for (int a = 0; a < 3; a++) {
+        calibration->hardIron[a] = (float)centre[a];
+        calibration->softIron[a] = (float)(meanRadius / radius[a]);
+    }
+    calibration.hasMagnetic = YES;
+}
+
+-(BOOL) correctMagnetic:(float *)m track:(VTCalibrationTrack *)track
+{
+    VTSensorCalibration *calibration = track.calibration;
+    if (!calibration.hasMagnetic) {
+        return NO;
+    }
+    for (int a = 0; a < 3; a++) {
+        m[a] = (m[a] - calibration->hardIron[a]) * calibration->softIron[a];
+    }
+    return YES;
+}
+
+#pragma mark - Gyroscope
+-(void) addGyro:(const float *)g track:(VTCalibrationTrack *)track
+{
+    for (int a = 0; a < 3; a++) {
+        track->gyroSum[a] += g[a];
+        track->gyroSumSquares[a] += (double)g[a] * g[a];
+    }
+    if (++track->gyroCount < stillWindow) {
+        return;
+    }
+
+    NSUInteger n = track->gyroCount;
+    double mean[3];
+    BOOL still = YES;
+    for (int a = 0; a < 3; a++) {
+        mean[a] = track->gyroSum[a] / n;
+        double variance = track->gyroSumSquares[a] / n - mean[a] * mean[a];
+        if (variance > (double)stillThreshold * stillThreshold || fabs(mean[a]) > maxBias) {
+            still = NO;
+        }
+    }
+    memset(track->gyroSum, 0, sizeof(track->gyroSum));
+    memset(track->gyroSumSquares, 0, sizeof(track->gyroSumSquares));
+    track->gyroCount = 0;
+
+    if (!still) {
+        return;
+    }
+
+    // The first still window sets the bias; later ones refine it slowly so drift is tracked
+    VTSensorCalibration *calibration = track.calibration;
+    float weight = calibration.hasGyroBias ? 0.2f : 1.0f;
+    for (int a = 0; a < 3; a++) {
+        calibration->gyroBias[a] += weight * ((float)mean[a] - calibration->gyroBias[a]);
+    }
+    calibration.hasGyroBias = YES;
+    calibration.stillWindows++;
+}
+
+-(BOOL) correctGyro:(float *)g track:(VTCalibrationTrack *)track
+{
+    VTSensorCalibration *calibration = track.calibration;
+    if (!calibration.hasGyroBias) {
+        return NO;
+    }
+    for (int a = 0; a < 3; a++) {
+        g[a] -= calibration->gyroBias[a];
+    }
+    return YES;
+}
+
+@end
@@ -22,14 +22,20 @@
 
 #import <UIKit/UIKit.h>
 #import "libNode.h"
+#import "VTContinuousScanner.h"
 
-@interface VTConnectionTable : UITableViewController <UITableViewDelegate, UITableViewDataSource, NodeControllerDelegate, NodeDeviceDelegate>
+@interface VTConnectionTable : UITableViewController <UITableViewDelegate, UITableViewDataSource, VTContinuousScannerDelegate, NodeDeviceDelegate>
 
 @property (weak, nonatomic) IBOutlet UITableView *MainTableView;
+@property (strong, nonatomic) VTContinuousScanner *scanner;
 
 
 #pragma mark - VTNodeController Delegate Methods
 - (void)nodeDeviceFound:(VTNodeDevice *)device;
 - (void)nodeControllerReady;
 
+#pragma mark - VTContinuousScanner Delegate Methods
+- (void)continuousScanner:(VTContinuousScanner *)aScanner didReportPresence:(VTPresenceEvent *)event;
+- (void)continuousScannerDidForgetDevices:(VTContinuousScanner *)aScanner;
+
 @end
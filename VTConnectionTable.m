@@ -28,6 +28,7 @@
 
 @implementation VTConnectionTable
 @synthesize MainTableView;
+@synthesize scanner;
 
 - (id)initWithStyle:(UITableViewStyle)style
 {
@@ -42,7 +43,9 @@
 {
     [super viewDidLoad];
     
-    [VTNodeController sharedInstance].delegate = self;
+    self.scanner = [[VTContinuousScanner alloc] init];
+    self.scanner.delegate = self;
+    [self.scanner start];
 
     // Preserve selection inbetween presentations
     self.clearsSelectionOnViewWillAppear = NO;
@@ -136,7 +139,13 @@
 
 - (void)tableView:(UITableView *)tableView didSelectRowAtIndexPath:(NSIndexPath *)indexPath
 {
-    VTNodeDevice* device = [[VTNodeController allNodeDevices] objectAtIndex:indexPath.row];
+    NSArray *devices = [VTNodeController allNodeDevices];
+    if (indexPath.row >= (NSInteger)[devices count]) {
+        // The devices were forgotten since the table was drawn
+        [tableView reloadData];
+        return;
+    }
+    VTNodeDevice* device = [devices objectAtIndex:indexPath.row];
     
     [device toggleConnection];
     
@@ -147,12 +156,24 @@
 - (void)nodeDeviceFound:(VTNodeDevice *)device
 {
     NSLog(@"Node device found");
-    [MainTableView reloadData];
 }
 - (void)nodeControllerReady
 {
     NSLog(@"Node Controller Ready");
-    [VTNodeController scanForNodeDevicesWithTimeout:15.0];
+}
+
+#pragma mark - VTContinuousScanner Delegate Methods
+- (void)continuousScanner:(VTContinuousScanner *)aScanner didReportPresence:(VTPresenceEvent *)event
+{
+    NSLog(@"Found %@", event.identifier);
+    [MainTableView reloadData];
+}
+
+// Rows index allNodeDevices, which has just been emptied
+- (void)continuousScannerDidForgetDevices:(VTContinuousScanner *)aScanner
+{
+    NSLog(@"Forgot all devices");
+    [MainTableView reloadData];
 }
 
 @end
@@ -0,0 +1,99 @@
+//
+//  VTContinuousScanner.h
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "libNode.h"
+#import "VTAdvertisementFilter.h"
+
+@class VTContinuousScanner;
+
+/** Delegate protocol for the VTContinuousScanner class.
+
+ The scanner takes over the VTNodeController delegate slot and forwards NodeControllerDelegate
+ callbacks to its own delegate unchanged.
+ */
+@protocol VTContinuousScannerDelegate <NodeControllerDelegate>
+@optional
+/** Invoked on the main thread when a device is found for the first time since the controller's
+ devices were last forgotten. Only VTPresenceAppeared is reported, and its rssi is NAN.
+ @param scanner The scanner
+ @param event The transition. Its context is the VTNodeDevice that was found.
+ */
+-(void) continuousScanner:(VTContinuousScanner *)scanner didReportPresence:(VTPresenceEvent *)event;
+
+/** Invoked on the main thread after the controller's devices have been forgotten. The arrays returned
+ by VTNodeController allNodeDevices before this are stale, and devices still nearby will be reported
+ as appearing again.
+ @param scanner The scanner
+ */
+-(void) continuousScannerDidForgetDevices:(VTContinuousScanner *)scanner;
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+/** Scans for Node devices indefinitely at a low duty cycle.
+
+ Every scanInterval seconds the scanner runs a scan of scanWindow seconds and feeds each
+ nodeDeviceFound: callback through a VTAdvertisementFilter, so the delegate hears once about each
+ device that appears.
+
+ VTNodeController only reports a device the first time it is found, and without the RSSI of its
+ advertisements, so the scanner cannot tell when a device moves or leaves. It never reports
+ VTPresenceMovedCloser, VTPresenceMovedAway or VTPresenceLost; those need a filter driven by every
+ advertisement.
+
+ VTNodeController keeps every device it has ever found. So that long unattended sessions stay
+ bounded, whenever the controller holds more than maxKnownDevices and no device is connected, the
+ scanner detaches them from the shared VTNodeDeviceHub, has the controller forget them all before
+ the next scan, resets its filter and tells the delegate. Devices still nearby are simply found
+ again. While running, the scanner is registered with the shared VTMemoryAccountant as "scanner";
+ trimming it forgets the controller's devices if none is connected.
+
+ The scanner is retained by the VTNodeController while it is the controller's delegate, and by its
+ timer while running; call stop to release it.
+ */
+@interface VTContinuousScanner : NSObject <NodeControllerDelegate, VTMemoryAccounting>
+
+/** The object that receives presence and controller events */
+@property (weak, nonatomic) NSObject<VTContinuousScannerDelegate> *delegate;
+/** The filter advertisements are passed through. Its handler is owned by the scanner. */
+@property (readonly, nonatomic) VTAdvertisementFilter *filter;
+/** Length of each scan in seconds (default 4) */
+@property (nonatomic) int scanWindow;
+/** Seconds from the start of one scan to the start of the next (default 20) */
+@property (nonatomic) NSTimeInterval scanInterval;
+/** Devices the controller may hold before they are forgotten, or 0 for no limit (default 64) */
+@property (nonatomic) NSUInteger maxKnownDevices;
+/** Number of times the controller's devices have been forgotten */
+@property (readonly, nonatomic) NSUInteger forgetCount;
+/** YES between start and stop */
+@property (readonly, nonatomic) BOOL isRunning;
+
+/** Makes the scanner the VTNodeController delegate and begins scanning.
+
+ If the controller has not reported nodeControllerReady yet, the first scan starts when it does,
+ so the scanner should be started before then (e.g. in viewDidLoad).
+ */
+-(void) start;
+
+/** Stops scanning. The scanner remains the controller's delegate. */
+-(void) stop;
+@end
@@ -0,0 +1,174 @@
+//
+//  VTContinuousScanner.m
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "VTContinuousScanner.h"
+#import "VTNodeSample.h"
+#import "VTNodeDeviceHub.h"
+#import <objc/runtime.h>
+#include <math.h>
+
+@interface VTContinuousScanner ()
+{
+    NSTimer *cycleTimer;
+    BOOL controllerReady;
+}
+@property (readwrite, nonatomic) BOOL isRunning;
+@property (readwrite, nonatomic) NSUInteger forgetCount;
+@end
+
+@implementation VTContinuousScanner
+
+@synthesize delegate;
+@synthesize filter;
+@synthesize scanWindow;
+@synthesize scanInterval;
+@synthesize maxKnownDevices;
+@synthesize forgetCount;
+@synthesize isRunning;
+
+-(id) init
+{
+    self = [super init];
+    if (self) {
+        scanWindow = 4;
+        scanInterval = 20.0;
+        maxKnownDevices = 64;
+        filter = [[VTAdvertisementFilter alloc] init];
+
+        __weak VTContinuousScanner *weakSelf = self;
+        filter.handler = ^(VTPresenceEvent *event) {
+            VTContinuousScanner *scanner = weakSelf;
+            NSObject<VTContinuousScannerDelegate> *target = scanner.delegate;
+            if ([target respondsToSelector:@selector(continuousScanner:didReportPresence:)]) {
+                [target continuousScanner:scanner didReportPresence:event];
+            }
+        };
+    }
+    return self;
+}
+
+-(void) setScanInterval:(NSTimeInterval)interval
+{
+    scanInterval = MAX(interval, scanWindow);
+    if (isRunning && controllerReady) {
+        [self scheduleCycle];
+    }
+}
+
+-(void) start
+{
+    [VTNodeController sharedInstance].delegate = self;
+    self.isRunning = YES;
+    if (controllerReady) {
+        [self scheduleCycle];
+    }
+    [[VTMemoryAccountant sharedInstance] registerSubsystem:self name:@"scanner"];
+}
+
+-(void) stop
+{
+    self.isRunning = NO;
+    [cycleTimer invalidate];
+    cycleTimer = nil;
+    [VTNodeController stopScan];
+    [[VTMemoryAccountant sharedInstance] unregisterSubsystem:self];
+}
+
+-(void) scheduleCycle
+{
+    [cycleTimer invalidate];
+    cycleTimer = [NSTimer scheduledTimerWithTimeInterval:scanInterval target:self selector:@selector(cycle:) userInfo:nil repeats:YES];
+    [self cycle:cycleTimer];
+}
+
+-(void) cycle:(NSTimer *)timer
+{
+    if (maxKnownDevices && [[VTNodeController allNodeDevices] count] > maxKnownDevices) {
+        [self forgetKnownDevices];
+    }
+    [VTNodeController scanForNodeDevicesWithTimeout:scanWindow];
+}
+
+// The controller can only forget all of its devices at once, so only do it while none is in use
+-(BOOL) forgetKnownDevices
+{
+    if ([[VTNodeController allConnectedNodeDevices] count]) {
+        return NO;
+    }
+    VTNodeDeviceHub *hub = [VTNodeDeviceHub sharedInstance];
+    for (VTNodeDevice *device in [VTNodeController allNodeDevices]) {
+        [hub detachDevice:device];
+    }
+    [VTNodeController forgetAllDevices];
+    self.forgetCount++;
+
+    // Devices found again must be reported as appearing, and anything indexing the controller's
+    // device list has to reload it
+    [filter reset];
+    if ([delegate respondsToSelector:@selector(continuousScannerDidForgetDevices:)]) {
+        [delegate continuousScannerDidForgetDevices:self];
+    }
+    return YES;
+}
+
+#pragma mark - Memory Accounting
+-(NSUInteger) memoryBytesUsed
+{
+    return [filter memoryBytesUsed] + [[VTNodeController allNodeDevices] count] * class_getInstanceSize([VTNodeDevice class]);
+}
+
+-(void) trimMemory
+{
+    [filter trimMemory];
+    if ([[VTNodeController allNodeDevices] count]) {
+        [self forgetKnownDevices];
+    }
+}
+
+#pragma mark - NodeControllerDelegate
+-(void) nodeControllerReady
+{
+    controllerReady = YES;
+    if (isRunning) {
+        [self scheduleCycle];
+    }
+
+    if ([delegate respondsToSelector:@selector(nodeControllerReady)]) {
+        [delegate nodeControllerReady];
+    }
+}
+
+// The controller only reports a device the first time it finds it, and the peripheral's RSSI is not
+// the advertisement's, so the filter never expires anything here and gets no signal strength
+-(void) nodeDeviceFound:(VTNodeDevice *)device
+{
+    [filter observeAdvertisementFrom:[VTNodeSample deviceIDForDevice:device]
+                                rssi:NAN
+                           timestamp:CFAbsoluteTimeGetCurrent()
+                             context:device];
+
+    if ([delegate respondsToSelector:@selector(nodeDeviceFound:)]) {
+        [delegate nodeDeviceFound:device];
+    }
+}
+
+@end
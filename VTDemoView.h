@@ -23,8 +23,11 @@
 #import <UIKit/UIKit.h>
 #import <inttypes.h>
 #import "libNode.h"
+#import "VTNodeDeviceHub.h"
+#import "VTReconnectSupervisor.h"
+#import "VTLedAnimator.h"
 
-@interface VTDemoView : UIViewController <NodeControllerDelegate, NodeDeviceDelegate, UINavigationControllerDelegate>
+@interface VTDemoView : UIViewController <NodeDeviceDelegate, VTReconnectSupervisorDelegate, UINavigationControllerDelegate>
 
 // UI
 @property (weak, nonatomic) IBOutlet UIScrollView *MainScrollView;
@@ -32,6 +35,8 @@
 
 // Device Information
 @property (retain, nonatomic) VTNodeDevice *TheDevice;
+@property (strong, nonatomic) VTReconnectSupervisor *Supervisor;
+@property (strong, nonatomic) VTLedAnimator *LedAnimator;
 @property (weak, nonatomic) IBOutlet UILabel *DeviceName;
 @property (weak, nonatomic) IBOutlet UILabel *DeviceInDataMode;
 @property (weak, nonatomic) IBOutlet UILabel *DeviceIsFullyConnected;
@@ -32,6 +32,8 @@
 @synthesize MainScrollView;
 @synthesize MainView;
 @synthesize TheDevice;
+@synthesize Supervisor;
+@synthesize LedAnimator;
 @synthesize DeviceName;
 @synthesize DeviceInDataMode;
 @synthesize DeviceIsFullyConnected;
@@ -104,14 +106,16 @@
 }
 
 // Grabs all relevant node delegates
+// Devices are attached to the shared hub, so other consumers keep receiving their callbacks.
+// The controller delegate stays with the connection table's VTContinuousScanner.
 - (void)grabNodeDelegates
 {
     
-    [VTNodeController sharedInstance].delegate = self;
-    
+    VTNodeDeviceHub *hub = [VTNodeDeviceHub sharedInstance];
     for (VTNodeDevice* device in [VTNodeController allNodeDevices]) {
-        device.delegate = self;
+        [hub attachDevice:device];
     }
+    [hub addDelegate:self];
     
 }
 
@@ -183,11 +187,17 @@
 }
 
 #pragma mark - Node Device Delegate
-// If a device disconnects jump back to the root view controller
+// If a device disconnects and is not being reconnected, jump back to the root view controller
 - (void)nodeDeviceDidDisconnect:(VTNodeDevice *)device
 {
     NSLog(@"Node Device Did Disconnect");
     
+    if (self.Supervisor.state != VTReconnectStateIdle) {
+        // The supervisor will reconnect and restore the streams
+        [self.DeviceConnected setText:@"NO (reconnecting)"];
+        return;
+    }
+    
     [self disconnectAllDevices];
     
     // Jump back to the root view controller
@@ -198,12 +208,32 @@
 - (void)nodeDeviceDidConnect:(VTNodeDevice *)device
 {
     NSLog(@"Device Did Connect");
-    device.delegate = self;
+    [[VTNodeDeviceHub sharedInstance] attachDevice:device];
     self.TheDevice = device;
     
+    if (self.Supervisor.device != device) {
+        [self.Supervisor stop];
+        self.Supervisor = [[VTReconnectSupervisor alloc] initWithDevice:device];
+        self.Supervisor.delegate = self;
+        [self.Supervisor start];
+    }
+    
     [self baseInit];
 }
 
+#pragma mark - Reconnect Supervisor Delegate
+- (void)reconnectSupervisor:(VTReconnectSupervisor *)supervisor didRecoverAfter:(NSTimeInterval)seconds attempts:(NSUInteger)attempts
+{
+    NSLog(@"Reconnected after %.1fs (%lu attempts, mean %.1fs)", seconds, (unsigned long)attempts, supervisor.meanRecoveryTime);
+}
+
+// Reconnecting failed, so give up the same way an unsupervised disconnect does
+- (void)reconnectSupervisorDidGiveUp:(VTReconnectSupervisor *)supervisor
+{
+    [self disconnectAllDevices];
+    [self.navigationController popToRootViewControllerAnimated:TRUE];
+}
+
 - (void)nodeDeviceButtonPushed:(VTNodeDevice *)device
 {
     [self.DeviceButtonPressed setText:@"True"];
@@ -439,11 +469,13 @@
             koreButton.selected = FALSE;
             NSLog(@"Stop Stream Acc, Gyro, Mag");
             [self.TheDevice setStreamModeAcc:FALSE Gyro:FALSE Mag:FALSE];
+            self.Supervisor.configuration.koreAcc = self.Supervisor.configuration.koreGyro = self.Supervisor.configuration.koreMag = FALSE;
         }
         else {
             koreButton.selected = TRUE;
             NSLog(@"Stream Acc, Gyro, Mag");
             [self.TheDevice setStreamModeAcc:TRUE Gyro:TRUE Mag:TRUE];
+            self.Supervisor.configuration.koreAcc = self.Supervisor.configuration.koreGyro = self.Supervisor.configuration.koreMag = TRUE;
         }
     }
 }
@@ -456,11 +488,13 @@
             quatButton.selected = FALSE;
             NSLog(@"Stop stream quat");
             [self.TheDevice setStreamModeOriYpr:FALSE QuatMode:FALSE];
+            self.Supervisor.configuration.oriQuat = FALSE;
         }
         else {
             quatButton.selected = TRUE;
             NSLog(@"Stream Quat");
             [self.TheDevice setStreamModeOriYpr:FALSE QuatMode:TRUE];
+            self.Supervisor.configuration.oriQuat = TRUE;
         }
     }
 }
@@ -473,11 +507,14 @@
             thermaButton.selected = FALSE;
             NSLog(@"Stop stream therma");
             [self.TheDevice setStreamModeIRThermo:FALSE];
+            self.Supervisor.configuration.irThermo = self.Supervisor.configuration.irThermoLed = FALSE;
         }
         else {
             thermaButton.selected = TRUE;
             NSLog(@"Stream therma");
+            // The short form also turns the spotting LED on
             [self.TheDevice setStreamModeIRThermo:TRUE];
+            self.Supervisor.configuration.irThermo = self.Supervisor.configuration.irThermoLed = TRUE;
         }
     }
 }
@@ -490,11 +527,13 @@
             climaButton.selected = FALSE;
             NSLog(@"Stop stream clima");
             [self.TheDevice setStreamModeClimaTP:FALSE Humidity:FALSE LightProximity:FALSE];
+            self.Supervisor.configuration.climaTempPressure = self.Supervisor.configuration.climaHumidity = self.Supervisor.configuration.climaLightProximity = FALSE;
         }
         else {
             climaButton.selected = TRUE;
             NSLog(@"Stream clima");
             [self.TheDevice setStreamModeClimaTP:TRUE Humidity:TRUE LightProximity:TRUE];
+            self.Supervisor.configuration.climaTempPressure = self.Supervisor.configuration.climaHumidity = self.Supervisor.configuration.climaLightProximity = TRUE;
         }
     }
 }
@@ -507,20 +546,30 @@
         if (lumaButton.selected == TRUE) {
             lumaButton.selected = FALSE;
             NSLog(@"Disable Luma");
-            [self.TheDevice setLumaMode:0];
+            if (self.LedAnimator.currentAnimation) {
+                // Cancelling turns the LUMA LEDs off
+                [self.LedAnimator cancel];
+            }
+            else {
+                [self.TheDevice setLumaMode:0];
+            }
+            self.Supervisor.configuration.lumaMode = 0;
         }
         else {
             lumaButton.selected = TRUE;
             NSLog(@"Enable Luma");
             
-            for (int i = 0; i < 10000; i++) {
-                if (i % 40 == 0) {
-                    [self.TheDevice setLumaMode:i/40];
-                }
+            // Fill the LUMA LEDs one at a time over a second, ending fully on
+            if (self.LedAnimator.device != self.TheDevice) {
+                [self.LedAnimator cancel];
+                self.LedAnimator = [[VTLedAnimator alloc] initWithDevice:self.TheDevice];
             }
+            VTLedAnimation *ramp = [[VTLedAnimation alloc] init];
+            [ramp setLumaMode:0 atTime:0 interpolation:VTLedInterpolationStep];
+            [ramp setLumaMode:255 atTime:1.0 interpolation:VTLedInterpolationLinear];
+            [self.LedAnimator runAnimation:ramp completion:nil];
             
-            [self.TheDevice setLumaMode:255];
-            
+            self.Supervisor.configuration.lumaMode = 255;
         }
     }
 }
@@ -531,7 +580,11 @@
 {
     
     if ([self.navigationController.viewControllers indexOfObject:self]==NSNotFound) {
+        // Stop supervising first so the disconnect below is not treated as a dropout
+        [self.Supervisor stop];
+        [self.LedAnimator cancel];
         [self disconnectAllDevices];
+        [[VTNodeDeviceHub sharedInstance] removeDelegate:self];
     }
     
     [super viewWillDisappear:animated];
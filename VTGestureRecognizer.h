@@ -0,0 +1,136 @@
+//
+//  VTGestureRecognizer.h
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "VTNodeDeviceHub.h"
+
+/** Kinds of event a VTGestureRecognizer can report */
+typedef enum {
+    /** A sharp, isolated acceleration spike */
+    VTMotionEventTap = 0,
+    /** A sustained, vigorous back-and-forth acceleration */
+    VTMotionEventShake,
+    /** A turn of at least rotationThreshold degrees; value is the signed angle in degrees */
+    VTMotionEventRotation,
+    /** Steps were taken; value is the number of new steps */
+    VTMotionEventSteps,
+    /** The activity state changed; see activity */
+    VTMotionEventActivityChanged,
+    VTMotionEventCount
+} VTMotionEventType;
+
+/** Mask bit for a single event type, for use with enabledEvents */
+#define VTMotionEventMask(type)     (1u << (type))
+/** Every event type */
+#define VTMotionEventMaskAll        ((1u << VTMotionEventCount) - 1)
+
+/** Activity states reported with VTMotionEventActivityChanged */
+typedef enum {
+    VTActivityUnknown = 0,
+    /** Lying still */
+    VTActivityStill,
+    /** Moving without a walking rhythm (carried, handled, fidgeting) */
+    VTActivityMoving,
+    VTActivityWalking,
+    VTActivityRunning
+} VTActivity;
+
+////////////////////////////////////////////////////////////////////////////////
+/** A recognized gesture or activity change */
+@interface VTMotionEvent : NSObject
+/** The kind of event */
+@property (readonly, nonatomic) VTMotionEventType type;
+/** The device the event came from */
+@property (readonly, weak, nonatomic) VTNodeDevice *device;
+/** The device identifier (see VTNodeSample deviceID) */
+@property (readonly, nonatomic) NSString *deviceID;
+/** Timestamp of the window the event was detected in */
+@property (readonly, nonatomic) NSTimeInterval timestamp;
+/** Event-specific value: degrees for rotations, new steps for steps, 0 otherwise */
+@property (readonly, nonatomic) float value;
+/** The activity state after the event */
+@property (readonly, nonatomic) VTActivity activity;
+@end
+
+@class VTGestureRecognizer;
+
+/** Delegate protocol for the VTGestureRecognizer class */
+@protocol VTGestureRecognizerDelegate <NSObject>
+@optional
+/** Invoked on the main thread with each recognized event
+
+ @param recognizer The recognizer
+ @param event The event
+ */
+-(void) gestureRecognizer:(VTGestureRecognizer *)recognizer didRecognizeEvent:(VTMotionEvent *)event;
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+/** Recognizes taps, shakes, rotations, steps and activity states from Kore streams.
+
+ The recognizer subscribes to the accelerometer and gyroscope channels of the shared hub and works
+ off the main thread. Each device's samples are collected into windows of windowLength samples,
+ advanced by half a window at a time. For each window a handful of features (acceleration
+ magnitude mean, deviation, extremes and jerk, mean-crossings, peak cadence, integrated rotation)
+ are computed with vDSP and run through a small fixed decision tree. Only the resulting events are
+ delivered; activity changes need two agreeing windows before they are reported.
+
+ Thresholds assume acceleration in g and angular rate in degrees per second, and a window of
+ roughly one second (50 samples at the default 20ms Kore period).
+ */
+@interface VTGestureRecognizer : NSObject
+
+/** The delegate object you want to receive events */
+@property (weak, nonatomic) NSObject<VTGestureRecognizerDelegate> *delegate;
+/** The events reported (a mask of VTMotionEventMask values, default all) */
+@property (nonatomic) uint32_t enabledEvents;
+/** Samples per analysis window, at least 16 (default 50). Takes effect on the next start. */
+@property (nonatomic) NSUInteger windowLength;
+/** Smallest turn, in degrees, reported as a rotation (default 90) */
+@property (nonatomic) float rotationThreshold;
+/** Seconds after a tap or shake during which another of the same kind is ignored (default 0.5) */
+@property (nonatomic) NSTimeInterval refractoryPeriod;
+/** True between start and stop */
+@property (readonly, nonatomic) bool isRunning;
+
+/** Subscribes to the shared hub and begins recognizing */
+-(void) start;
+/** Unsubscribes and forgets all per-device state */
+-(void) stop;
+
+/** Returns the current activity state of a device
+
+ @param deviceID The device identifier
+ @return The activity state, or VTActivityUnknown if the device has not been seen
+ */
+-(VTActivity) activityForDeviceID:(NSString *)deviceID;
+
+/** Runs samples through the recognizer synchronously and returns the events instead of delivering them
+
+ Used to replay recorded or synthetic sessions. The samples share per-device state with live
+ recognition, so use device identifiers the hub is not delivering.
+
+ @param samples VTNodeSample objects in time order; only accelerometer and gyroscope samples are used
+ @return The VTMotionEvent objects recognized, in order
+ */
+-(NSArray *) recognizeSamples:(NSArray *)samples;
+@end
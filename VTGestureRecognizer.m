@@ -0,0 +1,443 @@
+//
+//  VTGestureRecognizer.m
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "VTGestureRecognizer.h"
+#import <Accelerate/Accelerate.h>
+#include <math.h>
+
+// Decision tree thresholds (acceleration in g, angular rate in deg/s)
+static const float kStillDeviation = 0.02f;
+static const float kStillGyroRate = 5.0f;
+static const float kStepProminence = 0.05f;
+static const NSTimeInterval kMinStepInterval = 0.25;
+static const float kWalkMinCadence = 1.2f;
+static const float kRunMinCadence = 2.5f;
+static const float kRunMaxCadence = 4.5f;
+static const float kWalkMinDeviation = 0.08f;
+static const float kWalkMaxDeviation = 0.6f;
+static const float kRunMinDeviation = 0.3f;
+static const float kShakeMinDeviation = 0.7f;
+static const float kShakeMinCrossingRate = 8.0f;
+static const float kTapMinJerk = 0.8f;
+static const float kTapMaxDeviation = 0.35f;
+// Windows that must agree before the activity state changes
+static const NSUInteger kActivityHysteresis = 2;
+
+@interface VTMotionEvent ()
+@property (readwrite, nonatomic) VTMotionEventType type;
+@property (readwrite, weak, nonatomic) VTNodeDevice *device;
+@property (readwrite, nonatomic) NSString *deviceID;
+@property (readwrite, nonatomic) NSTimeInterval timestamp;
+@property (readwrite, nonatomic) float value;
+@property (readwrite, nonatomic) VTActivity activity;
+@end
+
+@implementation VTMotionEvent
+@synthesize type, device, deviceID, timestamp, value, activity;
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+// Window buffers and state for one device
+@interface VTMotionTrack : NSObject
+{
+@public
+    NSUInteger capacity;
+    float *acc[3];
+    NSTimeInterval *accTime;
+    NSUInteger accCount;
+    BOOL firstWindow;
+
+    float *gyro[3];
+    NSTimeInterval *gyroTime;
+    NSUInteger gyroCount;
+
+    VTActivity activity;
+    VTActivity candidate;
+    NSUInteger candidateWindows;
+    NSTimeInterval lastTap;
+    NSTimeInterval lastShake;
+    NSTimeInterval lastStep;
+}
+@property (weak, nonatomic) VTNodeDevice *device;
+@property (strong, nonatomic) NSString *deviceID;
+-(id) initWithCapacity:(NSUInteger)capacity;
+@end
+
+@implementation VTMotionTrack
+
+@synthesize device;
+@synthesize deviceID;
+
+-(id) initWithCapacity:(NSUInteger)aCapacity
+{
+    self = [super init];
+    if (self) {
+        capacity = aCapacity;
+        for (int a = 0; a < 3; a++) {
+            acc[a] = malloc(capacity * sizeof(float));
+            gyro[a] = malloc(capacity * sizeof(float));
+        }
+        accTime = malloc(capacity * sizeof(NSTimeInterval));
+        gyroTime = malloc(capacity * sizeof(NSTimeInterval));
+        firstWindow = YES;
+        lastTap = lastShake = lastStep = -INFINITY;
+    }
+    return self;
+}
+
+-(void) dealloc
+{
+    for (int a = 0; a < 3; a++) {
+        free(acc[a]);
+        free(gyro[a]);
+    }
+    free(accTime);
+    free(gyroTime);
+}
+
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+@interface VTGestureRecognizer ()
+{
+    dispatch_queue_t queue;
+    VTHubSubscription *subscription;
+
+    // Everything below is only touched on queue
+    NSUInteger window;
+    NSMutableDictionary *tracks;
+    float *magnitude;
+    float *scratch;
+}
+@property (readwrite, nonatomic) bool isRunning;
+@end
+
+@implementation VTGestureRecognizer
+
+@synthesize delegate;
+@synthesize enabledEvents;
+@synthesize windowLength;
+@synthesize rotationThreshold;
+@synthesize refractoryPeriod;
+@synthesize isRunning;
+
+-(id) init
+{
+    self = [super init];
+    if (self) {
+        enabledEvents = VTMotionEventMaskAll;
+        windowLength = 50;
+        rotationThreshold = 90.0f;
+        refractoryPeriod = 0.5;
+        queue = dispatch_queue_create("com.variabletech.gesture", DISPATCH_QUEUE_SERIAL);
+        tracks = [[NSMutableDictionary alloc] init];
+    }
+    return self;
+}
+
+-(void) dealloc
+{
+    // The hub may only be touched from the main thread, and the last reference can go away on queue
+    VTHubSubscription *pending = subscription;
+    if (pending) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [[VTNodeDeviceHub sharedInstance] unsubscribe:pending];
+        });
+    }
+    dispatch_release(queue);
+    free(magnitude);
+    free(scratch);
+}
+
+-(void) start
+{
+    if (isRunning) {
+        return;
+    }
+    self.isRunning = YES;
+
+    NSUInteger length = MAX(windowLength, 16);
+    dispatch_sync(queue, ^{
+        [self setUpWindow:length];
+    });
+
+    __weak VTGestureRecognizer *weakSelf = self;
+    uint32_t channels = VTSampleChannelMask(VTSampleChannelAcc) | VTSampleChannelMask(VTSampleChannelGyro);
+    subscription = [[VTNodeDeviceHub sharedInstance] subscribeToChannels:channels queue:queue handler:^(VTSampleBatch *batch) {
+        [weakSelf processBatch:batch];
+    }];
+}
+
+-(void) stop
+{
+    if (!isRunning) {
+        return;
+    }
+    self.isRunning = NO;
+    [[VTNodeDeviceHub sharedInstance] unsubscribe:subscription];
+    subscription = nil;
+    dispatch_sync(queue, ^{
+        [tracks removeAllObjects];
+    });
+}
+
+-(VTActivity) activityForDeviceID:(NSString *)deviceID
+{
+    __block VTActivity activity = VTActivityUnknown;
+    dispatch_sync(queue, ^{
+        VTMotionTrack *track = [tracks objectForKey:deviceID];
+        if (track) {
+            activity = track->activity;
+        }
+    });
+    return activity;
+}
+
+-(NSArray *) recognizeSamples:(NSArray *)samples
+{
+    NSMutableArray *events = [[NSMutableArray alloc] init];
+    NSUInteger length = MAX(windowLength, 16);
+    dispatch_sync(queue, ^{
+        if (window == 0) {
+            [self setUpWindow:length];
+        }
+        [self processSamples:samples into:events];
+    });
+    return events;
+}
+
+#pragma mark - Windowing
+// Forgets all tracks and sizes the buffers for windows of length samples; on queue
+-(void) setUpWindow:(NSUInteger)length
+{
+    window = length;
+    [tracks removeAllObjects];
+    magnitude = realloc(magnitude, window * sizeof(float));
+    scratch = realloc(scratch, window * sizeof(float));
+}
+
+-(void) processBatch:(VTSampleBatch *)batch
+{
+    NSMutableArray *events = [[NSMutableArray alloc] init];
+    [self processSamples:batch.samples into:events];
+
+    if ([events count] == 0) {
+        return;
+    }
+    dispatch_async(dispatch_get_main_queue(), ^{
+        NSObject<VTGestureRecognizerDelegate> *target = self.delegate;
+        if (![target respondsToSelector:@selector(gestureRecognizer:didRecognizeEvent:)]) {
+            return;
+        }
+        for (VTMotionEvent *event in events) {
+            [target gestureRecognizer:self didRecognizeEvent:event];
+        }
+    });
+}
+
+-(void) processSamples:(NSArray *)samples into:(NSMutableArray *)events
+{
+    NSUInteger hop = window / 2;
+
+    for (VTNodeSample *sample in samples) {
+        if (sample.channel != VTSampleChannelAcc && sample.channel != VTSampleChannelGyro) {
+            continue;
+        }
+        VTMotionTrack *track = [tracks objectForKey:sample.deviceID];
+        if (track == nil) {
+            track = [[VTMotionTrack alloc] initWithCapacity:window];
+            track.device = sample.device;
+            track.deviceID = sample.deviceID;
+            [tracks setObject:track forKey:sample.deviceID];
+        }
+
+        if (sample.channel == VTSampleChannelGyro) {
+            if (track->gyroCount == window) {
+                // Keep the gyro window sliding; it is read whenever an acc window completes
+                for (int a = 0; a < 3; a++) {
+                    memmove(track->gyro[a], track->gyro[a] + hop, (window - hop) * sizeof(float));
+                }
+                memmove(track->gyroTime, track->gyroTime + hop, (window - hop) * sizeof(NSTimeInterval));
+                track->gyroCount = window - hop;
+            }
+            NSUInteger i = track->gyroCount++;
+            track->gyro[0][i] = sample.x;
+            track->gyro[1][i] = sample.y;
+            track->gyro[2][i] = sample.z;
+            track->gyroTime[i] = sample.timestamp;
+            continue;
+        }
+
+        NSUInteger i = track->accCount++;
+        track->acc[0][i] = sample.x;
+        track->acc[1][i] = sample.y;
+        track->acc[2][i] = sample.z;
+        track->accTime[i] = sample.timestamp;
+
+        if (track->accCount == window) {
+            [self analyzeTrack:track newFrom:(track->firstWindow ? 0 : window - hop) into:events];
+            track->firstWindow = NO;
+            for (int a = 0; a < 3; a++) {
+                memmove(track->acc[a], track->acc[a] + hop, (window - hop) * sizeof(float));
+            }
+            memmove(track->accTime, track->accTime + hop, (window - hop) * sizeof(NSTimeInterval));
+            track->accCount = window - hop;
+        }
+    }
+}
+
+// Writes sqrt(x^2 + y^2 + z^2) for n samples into out, using scratch
+-(void) magnitudeOf:(float **)axes count:(NSUInteger)n into:(float *)out
+{
+    vDSP_vsq(axes[0], 1, out, 1, n);
+    vDSP_vsq(axes[1], 1, scratch, 1, n);
+    vDSP_vadd(out, 1, scratch, 1, out, 1, n);
+    vDSP_vsq(axes[2], 1, scratch, 1, n);
+    vDSP_vadd(out, 1, scratch, 1, out, 1, n);
+    int count = (int)n;
+    vvsqrtf(out, out, &count);
+}
+
+#pragma mark - Classification
+-(void) analyzeTrack:(VTMotionTrack *)track newFrom:(NSUInteger)newStart into:(NSMutableArray *)events
+{
+    NSUInteger n = window;
+    NSTimeInterval now = track->accTime[n - 1];
+    NSTimeInterval dt = (track->accTime[n - 1] - track->accTime[0]) / (n - 1);
+    if (dt <= 0) {
+        dt = 0.02;
+    }
+
+    // Acceleration magnitude features over the whole window
+    float mean, meanSquare, peak;
+    [self magnitudeOf:track->acc count:n into:magnitude];
+    vDSP_meanv(magnitude, 1, &mean, n);
+    vDSP_measqv(magnitude, 1, &meanSquare, n);
+    vDSP_maxv(magnitude, 1, &peak, n);
+    float deviation = sqrtf(MAX(0.0f, meanSquare - mean * mean));
+
+    float negativeMean = -mean;
+    vDSP_Length lastCrossing, crossings;
+    vDSP_vsadd(magnitude, 1, &negativeMean, scratch, 1, n);
+    vDSP_nzcros(scratch, 1, n, &lastCrossing, &crossings, n);
+    float crossingRate = crossings / (float)(n * dt);
+
+    // Jerk over the samples that are new in this window
+    NSUInteger jerkStart = newStart > 0 ? newStart - 1 : 0;
+    float jerk = 0;
+    vDSP_vsub(magnitude + jerkStart, 1, magnitude + jerkStart + 1, 1, scratch, 1, n - 1 - jerkStart);
+    vDSP_maxmgv(scratch, 1, &jerk, n - 1 - jerkStart);
+
+    // Step-like peaks among the new samples, and the previous window's last sample, which could not
+    // be judged without its successor
+    NSUInteger steps = 0;
+    float stepLevel = mean + MAX(0.5f * deviation, kStepProminence);
+    for (NSUInteger i = MAX(jerkStart, 1); i < n - 1; i++) {
+        if (magnitude[i] > stepLevel && magnitude[i] >= magnitude[i - 1] && magnitude[i] > magnitude[i + 1] &&
+            track->accTime[i] - track->lastStep >= kMinStepInterval) {
+            track->lastStep = track->accTime[i];
+            steps++;
+        }
+    }
+    float cadence = steps / (float)((n - newStart) * dt);
+
+    // Gyro features over whatever the gyro window holds
+    float gyroRate = 0;
+    float angle = 0;
+    NSUInteger gn = track->gyroCount;
+    if (gn > 1) {
+        NSTimeInterval gdt = (track->gyroTime[gn - 1] - track->gyroTime[0]) / (gn - 1);
+        [self magnitudeOf:track->gyro count:gn into:magnitude];
+        vDSP_meanv(magnitude, 1, &gyroRate, gn);
+        for (int a = 0; a < 3; a++) {
+            float sum;
+            vDSP_sve(track->gyro[a], 1, &sum, gn);
+            if (fabsf(sum * (float)gdt) > fabsf(angle)) {
+                angle = sum * (float)gdt;
+            }
+        }
+    }
+
+    // The tree
+    BOOL shake = deviation > kShakeMinDeviation && crossingRate >= kShakeMinCrossingRate;
+    VTActivity activity;
+    if (deviation < kStillDeviation && gyroRate < kStillGyroRate) {
+        activity = VTActivityStill;
+    }
+    else if (!shake && cadence >= kWalkMinCadence && cadence < kRunMinCadence && deviation >= kWalkMinDeviation && deviation < kWalkMaxDeviation) {
+        activity = VTActivityWalking;
+    }
+    else if (!shake && cadence >= kRunMinCadence && cadence < kRunMaxCadence && deviation >= kRunMinDeviation) {
+        activity = VTActivityRunning;
+    }
+    else {
+        activity = VTActivityMoving;
+    }
+    BOOL tap = !shake && jerk > kTapMinJerk && deviation < kTapMaxDeviation && activity != VTActivityWalking && activity != VTActivityRunning;
+
+    if (shake && now - track->lastShake >= refractoryPeriod) {
+        track->lastShake = now;
+        [self addEvent:VTMotionEventShake track:track timestamp:now value:0 into:events];
+    }
+    if (tap && now - track->lastTap >= refractoryPeriod) {
+        track->lastTap = now;
+        [self addEvent:VTMotionEventTap track:track timestamp:now value:0 into:events];
+    }
+    if (fabsf(angle) >= rotationThreshold) {
+        // Start integrating afresh so the same turn is not reported again by the next window
+        track->gyroCount = 0;
+        [self addEvent:VTMotionEventRotation track:track timestamp:now value:angle into:events];
+    }
+    if (steps > 0 && (activity == VTActivityWalking || activity == VTActivityRunning)) {
+        [self addEvent:VTMotionEventSteps track:track timestamp:now value:steps into:events];
+    }
+
+    if (activity == track->candidate) {
+        track->candidateWindows++;
+    }
+    else {
+        track->candidate = activity;
+        track->candidateWindows = 1;
+    }
+    if (track->candidateWindows >= kActivityHysteresis && track->activity != activity) {
+        track->activity = activity;
+        [self addEvent:VTMotionEventActivityChanged track:track timestamp:now value:0 into:events];
+    }
+}
+
+-(void) addEvent:(VTMotionEventType)type track:(VTMotionTrack *)track timestamp:(NSTimeInterval)timestamp value:(float)value into:(NSMutableArray *)events
+{
+    if (!(enabledEvents & VTMotionEventMask(type))) {
+        return;
+    }
+
+    VTMotionEvent *event = [[VTMotionEvent alloc] init];
+    event.type = type;
+    event.device = track.device;
+    event.deviceID = track.deviceID;
+    event.timestamp = timestamp;
+    event.value = value;
+    event.activity = track->activity;
+    [events addObject:event];
+}
+
+@end
@@ -0,0 +1,137 @@
+//
+//  VTIngestUploader.h
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "VTNodeSample.h"
+
+@class VTIngestUploader;
+
+/** Delegate protocol for the VTIngestUploader class. Callbacks are invoked on the main thread. */
+@protocol VTIngestUploaderDelegate <NSObject>
+@optional
+/** Invoked when a frame has been accepted by the server and removed from the spool
+
+ @param uploader The uploader
+ @param sequence The sequence number of the frame
+ */
+-(void) ingestUploader:(VTIngestUploader *)uploader didUploadFrame:(uint64_t)sequence;
+
+/** Invoked when the spool fills up or cannot be written and new samples start being refused, or
+ when frames can be spooled again
+
+ @param uploader The uploader
+ @param backPressured YES if samples are being refused
+ */
+-(void) ingestUploader:(VTIngestUploader *)uploader didChangeBackPressure:(BOOL)backPressured;
+
+/** Invoked when an upload fails. The frame stays in the spool and is retried.
+
+ @param uploader The uploader
+ @param error The error reported by the connection or by reading the frame, or nil for a non-2xx
+ response
+ */
+-(void) ingestUploader:(VTIngestUploader *)uploader uploadFailedWithError:(NSError *)error;
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+/** Batches samples from any number of Node devices into compressed frames and uploads them.
+
+ Samples are collected into frames of up to batchSize samples (or whatever arrived within
+ flushInterval). Each frame gets the next sequence number and is written to an on-disk spool before
+ any upload is attempted, so frames survive offline periods and app restarts. If a frame cannot be
+ compressed or written, its samples stay buffered for the next attempt and new samples are refused
+ until spooling works again. Frames are POSTed to the endpoint one at a time, oldest first, and are
+ only deleted from the spool once the server answers 2xx. After a failed upload, or a spooled frame
+ that cannot be read, uploads back off exponentially (2s doubling to 5 minutes) and new frames wait
+ in the spool until the retry. A frame that is retried keeps its sequence number, so the server can
+ discard duplicates by (uploader ID, sequence) and every frame is applied exactly once.
+
+ Frame layout (little endian):
+
+     "VTIF" | version (1 byte) | uploader ID (16 bytes) | sequence (8 bytes) | sample count (4 bytes)
+     | raw payload length (4 bytes) | CRC-32 of raw payload (4 bytes) | zlib-compressed payload
+
+ The raw payload is a device table (count, then length-prefixed UTF-8 device IDs) followed by one
+ record per sample: device index (1 byte), channel (1 byte), flags (1 byte), timestamp (8 byte
+ double) and the channel's float values.
+
+ The uploader ID and sequence number are also sent in the X-VT-Uploader and X-VT-Sequence request
+ headers.
+ */
+@interface VTIngestUploader : NSObject
+
+/** The delegate object you want to receive uploader events */
+@property (weak, nonatomic) NSObject<VTIngestUploaderDelegate> *delegate;
+/** The URL frames are POSTed to */
+@property (readonly, nonatomic) NSURL *endpoint;
+/** The directory frames are spooled to */
+@property (readonly, nonatomic) NSString *spoolDirectory;
+/** A persistent identifier for this uploader, sent with every frame */
+@property (readonly, nonatomic) NSString *uploaderID;
+/** Maximum number of samples per frame (default 500) */
+@property (nonatomic) NSUInteger batchSize;
+/** Seconds after which a partially filled frame is sealed (default 5) */
+@property (nonatomic) NSTimeInterval flushInterval;
+/** Spool size at which new samples are refused (default 32MB) */
+@property (nonatomic) unsigned long long maxSpoolBytes;
+/** True while the spool is full or failing to write, and samples are being refused */
+@property (readonly, nonatomic) BOOL isBackPressured;
+/** Number of samples refused because of back-pressure */
+@property (readonly, nonatomic) unsigned long long refusedSamples;
+/** Bytes currently held in the spool. Safe to read from any thread. */
+@property (readonly, nonatomic) unsigned long long spoolBytes;
+
+/** Returns an uploader spooling to the app's Caches directory
+
+ @param endpoint The URL frames are POSTed to
+ @return A VTIngestUploader object
+ */
+-(id) initWithEndpoint:(NSURL *)endpoint;
+
+/** Returns an uploader spooling to the given directory
+
+ Frames left in the directory by a previous run are uploaded first.
+
+ @param endpoint The URL frames are POSTed to
+ @param directory The spool directory (created if needed)
+ @return A VTIngestUploader object
+ */
+-(id) initWithEndpoint:(NSURL *)endpoint spoolDirectory:(NSString *)directory;
+
+/** Adds a sample to the current frame
+
+ @param sample The sample to add
+ @return NO if the sample was refused because of back-pressure
+ */
+-(BOOL) enqueueSample:(VTNodeSample *)sample;
+
+/** Adds several samples to the current frame
+
+ @param samples An array of VTNodeSample objects
+ @return NO if the samples were refused because of back-pressure
+ */
+-(BOOL) enqueueSamples:(NSArray *)samples;
+
+/** Seals the current frame and starts uploading it, unless an earlier upload failed and is still
+ waiting to be retried */
+-(void) flush;
+@end
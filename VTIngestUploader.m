@@ -0,0 +1,445 @@
+//
+//  VTIngestUploader.m
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "VTIngestUploader.h"
+#include <zlib.h>
+
+#define VT_INGEST_VERSION           1
+#define VT_INGEST_FRAME_SUFFIX      @"vtif"
+#define VT_INGEST_MAX_DEVICES       255
+#define VT_INGEST_MIN_RETRY         2.0
+#define VT_INGEST_MAX_RETRY         300.0
+
+static void VTAppendUInt8(NSMutableData *data, uint8_t v)
+{
+    [data appendBytes:&v length:1];
+}
+
+static void VTAppendUInt32(NSMutableData *data, uint32_t v)
+{
+    v = CFSwapInt32HostToLittle(v);
+    [data appendBytes:&v length:4];
+}
+
+static void VTAppendUInt64(NSMutableData *data, uint64_t v)
+{
+    v = CFSwapInt64HostToLittle(v);
+    [data appendBytes:&v length:8];
+}
+
+static void VTAppendFloat(NSMutableData *data, float f)
+{
+    CFSwappedFloat32 v = CFConvertFloat32HostToSwapped(f);
+    // CFSwappedFloat32 is big endian; byte-reverse it into little endian
+    VTAppendUInt32(data, CFSwapInt32BigToHost(v.v));
+}
+
+static void VTAppendDouble(NSMutableData *data, double d)
+{
+    CFSwappedFloat64 v = CFConvertFloat64HostToSwapped(d);
+    VTAppendUInt64(data, CFSwapInt64BigToHost(v.v));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+@interface VTIngestUploader ()
+{
+    dispatch_queue_t ioQueue;
+    dispatch_source_t flushTimer;
+    NSMutableArray *pending;
+    uint64_t nextSequence;
+    CFUUIDBytes uploaderBytes;
+    BOOL uploading;
+    NSTimeInterval retryDelay;
+    // Set while frames cannot be spooled; samples stay in pending and new ones are refused
+    BOOL spoolFailing;
+    // No upload is started before this time while backing off after a failure
+    CFAbsoluteTime retryAt;
+    volatile BOOL backPressured;
+    // Only changed on ioQueue (or in init, before it runs anything)
+    unsigned long long spoolBytes;
+}
+@property (readwrite, nonatomic) unsigned long long refusedSamples;
+@end
+
+@implementation VTIngestUploader
+
+@synthesize delegate;
+@synthesize endpoint;
+@synthesize spoolDirectory;
+@synthesize uploaderID;
+@synthesize batchSize;
+@synthesize flushInterval;
+@synthesize maxSpoolBytes;
+@synthesize refusedSamples;
+
+-(id) initWithEndpoint:(NSURL *)anEndpoint
+{
+    NSString *caches = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) objectAtIndex:0];
+    return [self initWithEndpoint:anEndpoint spoolDirectory:[caches stringByAppendingPathComponent:@"VTIngestSpool"]];
+}
+
+-(id) initWithEndpoint:(NSURL *)anEndpoint spoolDirectory:(NSString *)directory
+{
+    self = [super init];
+    if (self) {
+        endpoint = anEndpoint;
+        spoolDirectory = [directory copy];
+        batchSize = 500;
+        flushInterval = 5;
+        maxSpoolBytes = 32 * 1024 * 1024;
+        retryDelay = VT_INGEST_MIN_RETRY;
+        pending = [[NSMutableArray alloc] init];
+        ioQueue = dispatch_queue_create("com.variabletech.ingest", DISPATCH_QUEUE_SERIAL);
+
+        [[NSFileManager defaultManager] createDirectoryAtPath:spoolDirectory withIntermediateDirectories:YES attributes:nil error:nil];
+        [self loadState];
+        [self startFlushTimer];
+
+        dispatch_async(ioQueue, ^{
+            [self uploadNextFrame];
+        });
+    }
+    return self;
+}
+
+-(void) dealloc
+{
+    if (flushTimer) {
+        dispatch_source_cancel(flushTimer);
+        dispatch_release(flushTimer);
+    }
+    dispatch_release(ioQueue);
+}
+
+-(unsigned long long) spoolBytes
+{
+    __block unsigned long long bytes;
+    dispatch_sync(ioQueue, ^{
+        bytes = spoolBytes;
+    });
+    return bytes;
+}
+
+-(void) setFlushInterval:(NSTimeInterval)interval
+{
+    flushInterval = interval;
+    if (flushTimer) {
+        uint64_t nanoseconds = (uint64_t)(interval * NSEC_PER_SEC);
+        dispatch_source_set_timer(flushTimer, dispatch_time(DISPATCH_TIME_NOW, nanoseconds), nanoseconds, nanoseconds / 10);
+    }
+}
+
+-(BOOL) isBackPressured
+{
+    return backPressured;
+}
+
+#pragma mark - Persistent State
+-(NSString *) sequencePath
+{
+    return [spoolDirectory stringByAppendingPathComponent:@"sequence"];
+}
+
+-(void) loadState
+{
+    // Uploader identity
+    NSString *idPath = [spoolDirectory stringByAppendingPathComponent:@"uploader-id"];
+    NSString *storedID = [NSString stringWithContentsOfFile:idPath encoding:NSUTF8StringEncoding error:nil];
+    CFUUIDRef uuid = storedID ? CFUUIDCreateFromString(NULL, (__bridge CFStringRef)storedID) : NULL;
+    if (uuid == NULL) {
+        uuid = CFUUIDCreate(NULL);
+        storedID = (__bridge_transfer NSString *)CFUUIDCreateString(NULL, uuid);
+        [storedID writeToFile:idPath atomically:YES encoding:NSUTF8StringEncoding error:nil];
+    }
+    uploaderBytes = CFUUIDGetUUIDBytes(uuid);
+    uploaderID = storedID;
+    CFRelease(uuid);
+
+    // Next sequence number. Never reused, even if frames are lost.
+    NSString *storedSequence = [NSString stringWithContentsOfFile:[self sequencePath] encoding:NSUTF8StringEncoding error:nil];
+    nextSequence = storedSequence ? strtoull([storedSequence UTF8String], NULL, 10) : 0;
+
+    // Frames left over from a previous run
+    unsigned long long total = 0;
+    for (NSString *name in [self spooledFrameNames]) {
+        NSString *path = [spoolDirectory stringByAppendingPathComponent:name];
+        total += [[[NSFileManager defaultManager] attributesOfItemAtPath:path error:nil] fileSize];
+        uint64_t sequence = strtoull([name UTF8String], NULL, 10);
+        if (sequence >= nextSequence) {
+            nextSequence = sequence + 1;
+        }
+    }
+    spoolBytes = total;
+    backPressured = (total >= maxSpoolBytes);
+}
+
+// Spooled frame file names, oldest first
+-(NSArray *) spooledFrameNames
+{
+    NSArray *contents = [[NSFileManager defaultManager] contentsOfDirectoryAtPath:spoolDirectory error:nil];
+    NSPredicate *isFrame = [NSPredicate predicateWithFormat:@"pathExtension == %@", VT_INGEST_FRAME_SUFFIX];
+    // Names are zero padded, so lexical order is sequence order
+    return [[contents filteredArrayUsingPredicate:isFrame] sortedArrayUsingSelector:@selector(compare:)];
+}
+
+#pragma mark - Enqueue
+-(BOOL) enqueueSample:(VTNodeSample *)sample
+{
+    return [self enqueueSamples:[NSArray arrayWithObject:sample]];
+}
+
+-(BOOL) enqueueSamples:(NSArray *)samples
+{
+    NSUInteger n = [samples count];
+    if (backPressured) {
+        dispatch_async(ioQueue, ^{
+            self.refusedSamples += n;
+        });
+        return NO;
+    }
+
+    dispatch_async(ioQueue, ^{
+        [pending addObjectsFromArray:samples];
+        if ([pending count] >= batchSize) {
+            while ([pending count] >= batchSize && [self sealFrame]) {
+            }
+            [self uploadNextFrame];
+        }
+    });
+    return YES;
+}
+
+-(void) flush
+{
+    dispatch_async(ioQueue, ^{
+        while ([pending count] > 0 && [self sealFrame]) {
+        }
+        [self uploadNextFrame];
+    });
+}
+
+-(void) startFlushTimer
+{
+    flushTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, ioQueue);
+    uint64_t interval = (uint64_t)(flushInterval * NSEC_PER_SEC);
+    dispatch_source_set_timer(flushTimer, dispatch_time(DISPATCH_TIME_NOW, interval), interval, interval / 10);
+
+    __weak VTIngestUploader *weakSelf = self;
+    dispatch_source_set_event_handler(flushTimer, ^{
+        VTIngestUploader *strongSelf = weakSelf;
+        if (strongSelf && [strongSelf->pending count] > 0) {
+            [strongSelf sealFrame];
+            [strongSelf uploadNextFrame];
+        }
+    });
+    dispatch_resume(flushTimer);
+}
+
+#pragma mark - Framing
+// Encodes up to batchSize pending samples into a frame and writes it to the spool. Runs on ioQueue.
+// The samples and the sequence number are only consumed once the frame is in the spool; on failure
+// they stay pending for the next seal, and new samples are refused until a frame is spooled again.
+-(BOOL) sealFrame
+{
+    NSMutableData *payload = [[NSMutableData alloc] initWithCapacity:batchSize * 24];
+    NSMutableDictionary *deviceIndex = [[NSMutableDictionary alloc] init];
+    NSMutableArray *deviceIDs = [[NSMutableArray alloc] init];
+    NSMutableData *records = [[NSMutableData alloc] initWithCapacity:batchSize * 24];
+
+    NSUInteger consumed = 0;
+    NSUInteger limit = MIN([pending count], batchSize);
+    float values[4];
+    for (; consumed < limit; consumed++) {
+        VTNodeSample *sample = [pending objectAtIndex:consumed];
+        NSNumber *index = [deviceIndex objectForKey:sample.deviceID];
+        if (index == nil) {
+            if ([deviceIDs count] == VT_INGEST_MAX_DEVICES) {
+                // Device table is full; the rest goes in the next frame
+                break;
+            }
+            index = [NSNumber numberWithUnsignedInteger:[deviceIDs count]];
+            [deviceIndex setObject:index forKey:sample.deviceID];
+            [deviceIDs addObject:sample.deviceID];
+        }
+
+        VTAppendUInt8(records, [index unsignedCharValue]);
+        VTAppendUInt8(records, sample.channel);
+        VTAppendUInt8(records, sample.flags);
+        VTAppendDouble(records, sample.timestamp);
+        [sample getValues:values];
+        NSUInteger count = [VTNodeSample valueCountForChannel:sample.channel];
+        for (NSUInteger v = 0; v < count; v++) {
+            VTAppendFloat(records, values[v]);
+        }
+    }
+
+    VTAppendUInt8(payload, [deviceIDs count]);
+    for (NSString *deviceID in deviceIDs) {
+        NSData *utf8 = [deviceID dataUsingEncoding:NSUTF8StringEncoding];
+        VTAppendUInt8(payload, MIN([utf8 length], 255));
+        [payload appendBytes:[utf8 bytes] length:MIN([utf8 length], 255)];
+    }
+    [payload appendData:records];
+
+    uLongf compressedLength = compressBound([payload length]);
+    NSMutableData *compressed = [NSMutableData dataWithLength:compressedLength];
+    if (compress2([compressed mutableBytes], &compressedLength, [payload bytes], [payload length], Z_DEFAULT_COMPRESSION) != Z_OK) {
+        NSLog(@"Ingest: failed to compress frame of %lu samples; keeping them pending", (unsigned long)consumed);
+        [self setSpoolFailing:YES];
+        return NO;
+    }
+    [compressed setLength:compressedLength];
+
+    uint64_t sequence = nextSequence;
+
+    NSMutableData *frame = [[NSMutableData alloc] initWithCapacity:[compressed length] + 41];
+    [frame appendBytes:"VTIF" length:4];
+    VTAppendUInt8(frame, VT_INGEST_VERSION);
+    [frame appendBytes:&uploaderBytes length:sizeof(uploaderBytes)];
+    VTAppendUInt64(frame, sequence);
+    VTAppendUInt32(frame, consumed);
+    VTAppendUInt32(frame, [payload length]);
+    VTAppendUInt32(frame, crc32(0, [payload bytes], [payload length]));
+    [frame appendData:compressed];
+
+    NSString *name = [NSString stringWithFormat:@"%020llu.%@", sequence, VT_INGEST_FRAME_SUFFIX];
+    if (![frame writeToFile:[spoolDirectory stringByAppendingPathComponent:name] atomically:YES]) {
+        NSLog(@"Ingest: failed to spool frame %llu; keeping its samples pending", sequence);
+        [self setSpoolFailing:YES];
+        return NO;
+    }
+
+    // Consumed only now. A crash before the sequence is saved is covered by loadState, which skips
+    // past every spooled frame.
+    [pending removeObjectsInRange:NSMakeRange(0, consumed)];
+    nextSequence++;
+    NSString *sequenceString = [NSString stringWithFormat:@"%llu", nextSequence];
+    [sequenceString writeToFile:[self sequencePath] atomically:YES encoding:NSUTF8StringEncoding error:nil];
+
+    spoolBytes += [frame length];
+    spoolFailing = NO;
+    [self updateBackPressure];
+    return YES;
+}
+
+-(void) setSpoolFailing:(BOOL)failing
+{
+    spoolFailing = failing;
+    [self updateBackPressure];
+}
+
+-(void) updateBackPressure
+{
+    BOOL full = spoolFailing || (spoolBytes >= maxSpoolBytes);
+    if (full == backPressured) {
+        return;
+    }
+    backPressured = full;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        if ([self.delegate respondsToSelector:@selector(ingestUploader:didChangeBackPressure:)]) {
+            [self.delegate ingestUploader:self didChangeBackPressure:full];
+        }
+    });
+}
+
+#pragma mark - Upload
+// Uploads the oldest spooled frame, one request at a time. Runs on ioQueue. Sealing a frame only
+// calls this, so while a failed upload is backing off new frames just wait in the spool.
+-(void) uploadNextFrame
+{
+    if (uploading || CFAbsoluteTimeGetCurrent() < retryAt) {
+        return;
+    }
+    NSArray *names = [self spooledFrameNames];
+    if ([names count] == 0) {
+        return;
+    }
+
+    NSString *name = [names objectAtIndex:0];
+    NSString *path = [spoolDirectory stringByAppendingPathComponent:name];
+    NSError *readError = nil;
+    NSData *frame = [NSData dataWithContentsOfFile:path options:0 error:&readError];
+    if (frame == nil) {
+        // E.g. protected while the device is locked; never POST an empty body in its place
+        NSLog(@"Could not read spooled frame %@: %@", name, readError);
+        [self frameFailed:readError];
+        return;
+    }
+    uint64_t sequence = strtoull([name UTF8String], NULL, 10);
+
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:endpoint];
+    [request setHTTPMethod:@"POST"];
+    [request setValue:@"application/x-vt-ingest-frame" forHTTPHeaderField:@"Content-Type"];
+    [request setValue:uploaderID forHTTPHeaderField:@"X-VT-Uploader"];
+    [request setValue:[NSString stringWithFormat:@"%llu", sequence] forHTTPHeaderField:@"X-VT-Sequence"];
+    [request setHTTPBody:frame];
+
+    uploading = YES;
+    NSOperationQueue *callbackQueue = [[NSOperationQueue alloc] init];
+    [NSURLConnection sendAsynchronousRequest:request queue:callbackQueue completionHandler:^(NSURLResponse *response, NSData *data, NSError *error) {
+        NSInteger status = [response isKindOfClass:[NSHTTPURLResponse class]] ? [(NSHTTPURLResponse *)response statusCode] : 0;
+        dispatch_async(ioQueue, ^{
+            uploading = NO;
+            if (error == nil && status >= 200 && status < 300) {
+                [self frameUploaded:sequence path:path length:[frame length]];
+            }
+            else {
+                [self frameFailed:error];
+            }
+        });
+    }];
+}
+
+-(void) frameUploaded:(uint64_t)sequence path:(NSString *)path length:(NSUInteger)length
+{
+    [[NSFileManager defaultManager] removeItemAtPath:path error:nil];
+    spoolBytes -= MIN(spoolBytes, length);
+    retryDelay = VT_INGEST_MIN_RETRY;
+    [self updateBackPressure];
+
+    dispatch_async(dispatch_get_main_queue(), ^{
+        if ([self.delegate respondsToSelector:@selector(ingestUploader:didUploadFrame:)]) {
+            [self.delegate ingestUploader:self didUploadFrame:sequence];
+        }
+    });
+
+    [self uploadNextFrame];
+}
+
+-(void) frameFailed:(NSError *)error
+{
+    dispatch_async(dispatch_get_main_queue(), ^{
+        if ([self.delegate respondsToSelector:@selector(ingestUploader:uploadFailedWithError:)]) {
+            [self.delegate ingestUploader:self uploadFailedWithError:error];
+        }
+    });
+
+    NSTimeInterval delay = retryDelay;
+    retryDelay = MIN(retryDelay * 2, VT_INGEST_MAX_RETRY);
+    retryAt = CFAbsoluteTimeGetCurrent() + delay;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), ioQueue, ^{
+        retryAt = 0;
+        [self uploadNextFrame];
+    });
+}
+
+@end
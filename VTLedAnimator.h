@@ -0,0 +1,142 @@
+//
+//  VTLedAnimator.h
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "libNode.h"
+
+/** How a keyframe is reached from the one before it */
+typedef enum {
+    /** Jump to the keyframe's value at its time */
+    VTLedInterpolationStep = 0,
+    /** Ramp from the previous keyframe's value so the keyframe's value is reached at its time. For
+     the LUMA module the number of lit LEDs is ramped, filling from LED 0 upwards. */
+    VTLedInterpolationLinear
+} VTLedInterpolation;
+
+////////////////////////////////////////////////////////////////////////////////
+/** A keyframe animation of the Node's LEDs and the LUMA module.
+
+ Keyframes are placed on two independent tracks, the four Node LEDs and the LUMA LED mask, at times
+ in seconds from the start of the animation. Keyframes are added in time order within each track.
+ */
+@interface VTLedAnimation : NSObject
+
+/** An animation only preempts a running animation of the same or lower priority (default 0) */
+@property (nonatomic) NSInteger priority;
+/** Times the animation plays, or 0 to repeat until cancelled or preempted (default 1) */
+@property (nonatomic) NSUInteger repeatCount;
+/** Length of one play: the time of the last keyframe, or the end of the last pulse */
+@property (readonly, nonatomic) NSTimeInterval duration;
+
+/** Adds a keyframe to the LED track
+
+ @param aBlue Brightness of the first blue LED (0-255)
+ @param bBlue Brightness of the second blue LED
+ @param aRed Brightness of the first red LED
+ @param bRed Brightness of the second red LED
+ @param time Seconds from the start of the animation
+ @param interpolation How the value is reached
+ */
+-(void) setLedsABlue:(uint8_t)aBlue BBlue:(uint8_t)bBlue ARed:(uint8_t)aRed BRed:(uint8_t)bRed atTime:(NSTimeInterval)time interpolation:(VTLedInterpolation)interpolation;
+
+/** Adds a pulse to the LED track. The device pulses on its own, so this costs a single command.
+ The LEDs are off when the pulse ends.
+
+ @param aBlue Peak brightness of the first blue LED (0-255)
+ @param bBlue Peak brightness of the second blue LED
+ @param aRed Peak brightness of the first red LED
+ @param bRed Peak brightness of the second red LED
+ @param time Seconds from the start of the animation
+ @param duration Seconds to pulse for
+ @param period Seconds per on-off cycle
+ */
+-(void) pulseLedsABlue:(uint8_t)aBlue BBlue:(uint8_t)bBlue ARed:(uint8_t)aRed BRed:(uint8_t)bRed atTime:(NSTimeInterval)time duration:(NSTimeInterval)duration period:(NSTimeInterval)period;
+
+/** Adds a keyframe to the LUMA track
+
+ @param mode The LUMA LED mask, as passed to setLumaMode:
+ @param time Seconds from the start of the animation
+ @param interpolation How the value is reached
+ */
+-(void) setLumaMode:(uint8_t)mode atTime:(NSTimeInterval)time interpolation:(VTLedInterpolation)interpolation;
+
+/** Returns the number of device commands one play compiles to
+
+ @param interval The spacing of commands, as used by VTLedAnimator
+ @return The number of commands
+ */
+-(NSUInteger) commandCountWithInterval:(NSTimeInterval)interval;
+@end
+
+/** Block invoked when an animation ends; finished is NO if it was cancelled or preempted */
+typedef void (^VTLedAnimationCompletion)(BOOL finished);
+
+////////////////////////////////////////////////////////////////////////////////
+/** Plays VTLedAnimation objects on a device with as few, and as evenly spaced, writes as possible.
+
+ An animation is compiled before it starts. Held values are sent as ledsOn with a duration, so a
+ following "off" keyframe costs nothing and the LEDs go dark on their own if the app stops. Pulses
+ use the device's own ledsPulse. Only ramps need a command per step; they are sampled once per
+ command interval and unchanged steps are skipped. Keyframes closer together than the command
+ interval are coalesced, the later one winning.
+
+ Commands go out at most once per command interval, which is 1 / maxCommandRate rounded up to a
+ whole number of connection intervals, so effects take a fixed, small share of the radio instead of
+ competing with sensor streams. When both tracks are due at once, the one due first goes out first.
+
+ Use it from the main thread.
+ */
+@interface VTLedAnimator : NSObject
+
+/** The device animated */
+@property (weak, readonly, nonatomic) VTNodeDevice *device;
+/** Most commands sent per second (default 10) */
+@property (nonatomic) double maxCommandRate;
+/** The BLE connection interval commands are aligned to, in seconds (default 0.03) */
+@property (nonatomic) NSTimeInterval connectionInterval;
+/** The seconds between commands implied by maxCommandRate and connectionInterval */
+@property (readonly, nonatomic) NSTimeInterval commandInterval;
+/** The animation being played, or nil */
+@property (readonly, nonatomic) VTLedAnimation *currentAnimation;
+/** Total commands sent to the device */
+@property (readonly, nonatomic) unsigned long long commandsSent;
+
+/** Returns an animator
+
+ @param device The device to animate
+ @return A VTLedAnimator object
+ */
+-(id) initWithDevice:(VTNodeDevice *)device;
+
+/** Starts an animation, preempting the current one unless it has a higher priority
+
+ Tracks the preempted animation used and the new one does not are turned off.
+
+ @param animation The animation to play
+ @param completion Invoked on the main thread when the animation ends (may be nil)
+ @return NO if a higher-priority animation is playing
+ */
+-(BOOL) runAnimation:(VTLedAnimation *)animation completion:(VTLedAnimationCompletion)completion;
+
+/** Stops the current animation and turns off the tracks it used */
+-(void) cancel;
+@end
@@ -0,0 +1,497 @@
+//
+//  VTLedAnimator.m
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "VTLedAnimator.h"
+#include <math.h>
+
+typedef enum {
+    VTLedTrackLeds = 0,
+    VTLedTrackLuma,
+    VTLedTrackCount
+} VTLedTrack;
+
+typedef enum {
+    VTLedKeyframeStep = 0,
+    VTLedKeyframeLinear,
+    VTLedKeyframePulse
+} VTLedKeyframeKind;
+
+typedef struct {
+    double time;
+    double duration;
+    double period;
+    uint8_t values[4];
+    uint8_t track;
+    uint8_t kind;
+} VTLedKeyframe;
+
+// A point where a track changes: a level, or a pulse that the device plays by itself
+typedef struct {
+    double time;
+    double duration;
+    double period;
+    uint8_t values[4];
+    BOOL pulse;
+} VTLedEvent;
+
+typedef enum {
+    VTLedCommandOn = 0,     // ledsOn with a duration
+    VTLedCommandSet,        // setLedABlue, held until changed
+    VTLedCommandPulse,
+    VTLedCommandOff,
+    VTLedCommandLuma
+} VTLedCommandKind;
+
+typedef struct {
+    double time;
+    uint16_t duration;
+    uint16_t period;
+    uint8_t values[4];
+    uint8_t track;
+    uint8_t kind;
+} VTLedCommand;
+
+#pragma mark - Compilation
+static BOOL VTLedIsZero(const uint8_t *v)
+{
+    return (v[0] | v[1] | v[2] | v[3]) == 0;
+}
+
+// Device durations are in 10ms units
+static uint16_t VTLedUnits(double seconds)
+{
+    return (uint16_t)MIN(65535, MAX(1, lround(seconds * 100)));
+}
+
+static uint8_t VTLumaFill(int lit)
+{
+    return (uint8_t)((1u << MAX(0, MIN(8, lit))) - 1);
+}
+
+// Appends an event aligned to the connection interval, replacing earlier events closer than interval
+static void VTLedAddEvent(NSMutableData *events, VTLedEvent e, double interval, double connection)
+{
+    e.time = round(e.time / connection) * connection;
+    while ([events length]) {
+        VTLedEvent *last = (VTLedEvent *)[events mutableBytes] + [events length] / sizeof(VTLedEvent) - 1;
+        if (e.time - last->time > interval - 1e-6) {
+            break;
+        }
+        [events setLength:[events length] - sizeof(VTLedEvent)];
+    }
+    [events appendBytes:&e length:sizeof(e)];
+}
+
+// Turns one track's keyframes into events, sampling ramps once per interval
+static NSData *VTLedTrackEvents(const VTLedKeyframe *keyframes, NSUInteger count, VTLedTrack track, double interval, double connection)
+{
+    NSMutableData *events = [[NSMutableData alloc] init];
+    uint8_t level[4] = { 0, 0, 0, 0 };
+    double levelTime = 0;
+
+    for (NSUInteger i = 0; i < count; i++) {
+        const VTLedKeyframe *k = &keyframes[i];
+        if (k->track != track) {
+            continue;
+        }
+
+        if (k->kind == VTLedKeyframeLinear && k->time > levelTime) {
+            double span = k->time - levelTime;
+            uint8_t last[4];
+            memcpy(last, level, sizeof(last));
+            for (double t = levelTime + interval; t < k->time - 1e-6; t += interval) {
+                double f = (t - levelTime) / span;
+                VTLedEvent e = { t, 0, 0, { 0, 0, 0, 0 }, NO };
+                if (track == VTLedTrackLuma) {
+                    int from = __builtin_popcount(level[0]), to = __builtin_popcount(k->values[0]);
+                    e.values[0] = VTLumaFill((int)lround(from + f * (to - from)));
+                }
+                else {
+                    for (int c = 0; c < 4; c++) {
+                        e.values[c] = (uint8_t)lround(level[c] + f * ((int)k->values[c] - (int)level[c]));
+                    }
+                }
+                if (memcmp(e.values, last, sizeof(last)) != 0) {
+                    VTLedAddEvent(events, e, interval, connection);
+                    memcpy(last, e.values, sizeof(last));
+                }
+            }
+        }
+
+        VTLedEvent e = { k->time, k->duration, k->period, { 0, 0, 0, 0 }, k->kind == VTLedKeyframePulse };
+        memcpy(e.values, k->values, sizeof(e.values));
+        VTLedAddEvent(events, e, interval, connection);
+
+        if (e.pulse) {
+            memset(level, 0, sizeof(level));
+            levelTime = k->time + k->duration;
+        }
+        else {
+            memcpy(level, k->values, sizeof(level));
+            levelTime = k->time;
+        }
+    }
+    return events;
+}
+
+// Emits the fewest LED commands for a track's events. lit says whether the LEDs are on at the start;
+// returns the time until which the last command keeps them on.
+static double VTLedEmitLeds(NSData *eventData, BOOL lit, double interval, NSMutableData *commands)
+{
+    const VTLedEvent *events = [eventData bytes];
+    NSUInteger count = [eventData length] / sizeof(VTLedEvent);
+    double onUntil = lit ? INFINITY : -INFINITY;
+    const uint8_t *previous = NULL;
+
+    for (NSUInteger j = 0; j < count; j++) {
+        const VTLedEvent *e = &events[j];
+        const VTLedEvent *next = j + 1 < count ? &events[j + 1] : NULL;
+        VTLedCommand command = { e->time, 0, 0, { 0, 0, 0, 0 }, VTLedTrackLeds, VTLedCommandOn };
+        memcpy(command.values, e->values, sizeof(command.values));
+
+        if (e->pulse) {
+            command.kind = VTLedCommandPulse;
+            command.duration = VTLedUnits(e->duration);
+            command.period = VTLedUnits(e->period);
+            onUntil = e->time + e->duration;
+            previous = NULL;
+        }
+        else if (previous && memcmp(previous, e->values, 4) == 0) {
+            // Unchanged; the command that set it already covers this span
+            continue;
+        }
+        else if (VTLedIsZero(e->values)) {
+            previous = e->values;
+            if (onUntil <= e->time + 0.006) {
+                // Already dark: the last ledsOn or pulse ran out here (to the 10ms resolution of durations)
+                onUntil = -INFINITY;
+                continue;
+            }
+            command.kind = VTLedCommandOff;
+            onUntil = -INFINITY;
+        }
+        else {
+            previous = e->values;
+            // Find where this level ends
+            const VTLedEvent *end = next;
+            for (NSUInteger n = j + 1; end && !end->pulse && memcmp(end->values, e->values, 4) == 0; n++) {
+                end = n + 1 < count ? &events[n + 1] : NULL;
+            }
+            if (end) {
+                // Run out exactly when the LEDs should go dark; otherwise overlap the next command a little
+                double hold = end->time - e->time + (end->pulse || !VTLedIsZero(end->values) ? interval : 0);
+                if (hold * 100 <= 65535) {
+                    command.duration = VTLedUnits(hold);
+                    onUntil = e->time + command.duration / 100.0;
+                }
+                else {
+                    command.kind = VTLedCommandSet;
+                    onUntil = INFINITY;
+                }
+            }
+            else {
+                command.kind = VTLedCommandSet;
+                onUntil = INFINITY;
+            }
+        }
+        [commands appendBytes:&command length:sizeof(command)];
+    }
+    return onUntil;
+}
+
+static void VTLedEmitLuma(NSData *eventData, NSMutableData *commands)
+{
+    const VTLedEvent *events = [eventData bytes];
+    NSUInteger count = [eventData length] / sizeof(VTLedEvent);
+    int previous = -1;
+
+    for (NSUInteger j = 0; j < count; j++) {
+        if (events[j].values[0] == previous) {
+            continue;
+        }
+        previous = events[j].values[0];
+        VTLedCommand command = { events[j].time, 0, 0, { events[j].values[0], 0, 0, 0 }, VTLedTrackLuma, VTLedCommandLuma };
+        [commands appendBytes:&command length:sizeof(command)];
+    }
+}
+
+static int VTLedCompareCommands(const void *a, const void *b)
+{
+    const VTLedCommand *x = a, *y = b;
+    if (x->time != y->time) {
+        return x->time < y->time ? -1 : 1;
+    }
+    return (int)x->track - (int)y->track;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+@interface VTLedAnimation ()
+{
+    NSMutableData *keyframes;
+    double lastTime[VTLedTrackCount];
+}
+@property (readwrite, nonatomic) NSTimeInterval duration;
+@property (readonly, nonatomic) uint32_t trackMask;
+-(NSData *) compileWithInterval:(double)interval connection:(double)connection;
+@end
+
+@implementation VTLedAnimation
+
+@synthesize priority;
+@synthesize repeatCount;
+@synthesize duration;
+@synthesize trackMask;
+
+-(id) init
+{
+    self = [super init];
+    if (self) {
+        repeatCount = 1;
+        keyframes = [[NSMutableData alloc] init];
+    }
+    return self;
+}
+
+-(void) addKeyframe:(VTLedKeyframe)keyframe
+{
+    if (keyframe.time < lastTime[keyframe.track]) {
+        NSLog(@"LED keyframe at %.3fs is earlier than the previous one on its track; ignored", keyframe.time);
+        return;
+    }
+    lastTime[keyframe.track] = keyframe.time;
+    trackMask |= 1u << keyframe.track;
+    self.duration = MAX(duration, keyframe.time + keyframe.duration);
+    [keyframes appendBytes:&keyframe length:sizeof(keyframe)];
+}
+
+-(void) setLedsABlue:(uint8_t)aBlue BBlue:(uint8_t)bBlue ARed:(uint8_t)aRed BRed:(uint8_t)bRed atTime:(NSTimeInterval)time interpolation:(VTLedInterpolation)interpolation
+{
+    VTLedKeyframe keyframe = { MAX(time, 0), 0, 0, { aBlue, bBlue, aRed, bRed }, VTLedTrackLeds,
+                               interpolation == VTLedInterpolationLinear ? VTLedKeyframeLinear : VTLedKeyframeStep };
+    [self addKeyframe:keyframe];
+}
+
+-(void) pulseLedsABlue:(uint8_t)aBlue BBlue:(uint8_t)bBlue ARed:(uint8_t)aRed BRed:(uint8_t)bRed atTime:(NSTimeInterval)time duration:(NSTimeInterval)aDuration period:(NSTimeInterval)period
+{
+    VTLedKeyframe keyframe = { MAX(time, 0), MAX(aDuration, 0.01), MAX(period, 0.01), { aBlue, bBlue, aRed, bRed }, VTLedTrackLeds, VTLedKeyframePulse };
+    [self addKeyframe:keyframe];
+}
+
+-(void) setLumaMode:(uint8_t)mode atTime:(NSTimeInterval)time interpolation:(VTLedInterpolation)interpolation
+{
+    VTLedKeyframe keyframe = { MAX(time, 0), 0, 0, { mode, 0, 0, 0 }, VTLedTrackLuma,
+                               interpolation == VTLedInterpolationLinear ? VTLedKeyframeLinear : VTLedKeyframeStep };
+    [self addKeyframe:keyframe];
+}
+
+-(NSData *) compileWithInterval:(double)interval connection:(double)connection
+{
+    const VTLedKeyframe *k = [keyframes bytes];
+    NSUInteger count = [keyframes length] / sizeof(VTLedKeyframe);
+    NSMutableData *commands = [[NSMutableData alloc] init];
+
+    NSData *leds = VTLedTrackEvents(k, count, VTLedTrackLeds, interval, connection);
+    BOOL litAtEnd = VTLedEmitLeds(leds, NO, interval, [NSMutableData data]) > duration + 0.006;
+    // A repeating animation starts each play in the state the previous one ended in
+    VTLedEmitLeds(leds, repeatCount != 1 && litAtEnd, interval, commands);
+    VTLedEmitLuma(VTLedTrackEvents(k, count, VTLedTrackLuma, interval, connection), commands);
+
+    qsort([commands mutableBytes], [commands length] / sizeof(VTLedCommand), sizeof(VTLedCommand), VTLedCompareCommands);
+    return commands;
+}
+
+-(NSUInteger) commandCountWithInterval:(NSTimeInterval)interval
+{
+    return [[self compileWithInterval:interval connection:interval] length] / sizeof(VTLedCommand);
+}
+
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+@interface VTLedAnimator ()
+{
+    NSData *commands;
+    NSUInteger cursor;
+    NSUInteger cycle;
+    CFAbsoluteTime startTime;
+    NSTimer *tickTimer;
+    // The latest due command of each track that has not been sent yet
+    VTLedCommand pending[VTLedTrackCount];
+    BOOL hasPending[VTLedTrackCount];
+}
+@property (weak, readwrite, nonatomic) VTNodeDevice *device;
+@property (readwrite, nonatomic) VTLedAnimation *currentAnimation;
+@property (readwrite, nonatomic) unsigned long long commandsSent;
+@property (copy, nonatomic) VTLedAnimationCompletion completion;
+@end
+
+@implementation VTLedAnimator
+
+@synthesize device;
+@synthesize maxCommandRate;
+@synthesize connectionInterval;
+@synthesize currentAnimation;
+@synthesize commandsSent;
+@synthesize completion;
+
+-(id) initWithDevice:(VTNodeDevice *)aDevice
+{
+    self = [super init];
+    if (self) {
+        device = aDevice;
+        maxCommandRate = 10.0;
+        connectionInterval = 0.03;
+    }
+    return self;
+}
+
+-(NSTimeInterval) commandInterval
+{
+    double connection = MAX(connectionInterval, 0.0075);
+    double interval = MAX(1.0 / MAX(maxCommandRate, 0.1), connection);
+    return ceil(interval / connection - 1e-9) * connection;
+}
+
+#pragma mark - Playback
+-(BOOL) runAnimation:(VTLedAnimation *)animation completion:(VTLedAnimationCompletion)aCompletion
+{
+    if (currentAnimation && animation.priority < currentAnimation.priority) {
+        return NO;
+    }
+    uint32_t unused = currentAnimation.trackMask & ~animation.trackMask;
+    [self stopFinished:NO turnOff:unused];
+
+    NSTimeInterval interval = self.commandInterval;
+    commands = [animation compileWithInterval:interval connection:MAX(connectionInterval, 0.0075)];
+    cursor = 0;
+    cycle = 0;
+    memset(hasPending, 0, sizeof(hasPending));
+    self.currentAnimation = animation;
+    self.completion = aCompletion;
+
+    startTime = CFAbsoluteTimeGetCurrent();
+    tickTimer = [NSTimer scheduledTimerWithTimeInterval:interval target:self selector:@selector(tick:) userInfo:nil repeats:YES];
+    [self tick:tickTimer];
+    return YES;
+}
+
+-(void) cancel
+{
+    [self stopFinished:NO turnOff:currentAnimation.trackMask];
+}
+
+-(void) stopFinished:(BOOL)finished turnOff:(uint32_t)tracks
+{
+    if (currentAnimation == nil) {
+        return;
+    }
+    [tickTimer invalidate];
+    tickTimer = nil;
+    commands = nil;
+    self.currentAnimation = nil;
+
+    if (tracks & (1u << VTLedTrackLeds)) {
+        [device ledsOff];
+        self.commandsSent++;
+    }
+    if (tracks & (1u << VTLedTrackLuma)) {
+        [device setLumaMode:0];
+        self.commandsSent++;
+    }
+
+    VTLedAnimationCompletion done = self.completion;
+    self.completion = nil;
+    if (done) {
+        done(finished);
+    }
+}
+
+-(void) tick:(NSTimer *)timer
+{
+    VTLedAnimation *animation = currentAnimation;
+    const VTLedCommand *list = [commands bytes];
+    NSUInteger count = [commands length] / sizeof(VTLedCommand);
+    // A zero-length animation cannot repeat
+    NSUInteger plays = animation.duration > 0 ? animation.repeatCount : 1;
+    double elapsed = CFAbsoluteTimeGetCurrent() - startTime;
+
+    // Collect everything that is due, keeping only the latest command of each track
+    while (plays == 0 || cycle < plays) {
+        if (cursor == count) {
+            if (elapsed < (cycle + 1) * animation.duration) {
+                break;
+            }
+            cycle++;
+            cursor = 0;
+            continue;
+        }
+        VTLedCommand command = list[cursor];
+        command.time += cycle * animation.duration;
+        if (command.time > elapsed + 1e-3) {
+            break;
+        }
+        pending[command.track] = command;
+        hasPending[command.track] = YES;
+        cursor++;
+    }
+
+    // Send at most one command per tick, the one due first
+    int track = -1;
+    for (int t = 0; t < VTLedTrackCount; t++) {
+        if (hasPending[t] && (track < 0 || pending[t].time < pending[track].time)) {
+            track = t;
+        }
+    }
+    if (track >= 0) {
+        hasPending[track] = NO;
+        [self send:&pending[track]];
+    }
+
+    if (plays && cycle >= plays && !hasPending[VTLedTrackLeds] && !hasPending[VTLedTrackLuma]) {
+        [self stopFinished:YES turnOff:0];
+    }
+}
+
+-(void) send:(const VTLedCommand *)command
+{
+    const uint8_t *v = command->values;
+    switch (command->kind) {
+        case VTLedCommandOn:
+            [device ledsOn:v[0] led2B:v[1] led1R:v[2] led2R:v[3] duration:command->duration];
+            break;
+        case VTLedCommandSet:
+            [device setLedABlue:v[0] BBlue:v[1] ARed:v[2] BRed:v[3]];
+            break;
+        case VTLedCommandPulse:
+            [device ledsPulse:v[0] led2B:v[1] led1R:v[2] led2R:v[3] duration:command->duration pulseFrequency:command->period];
+            break;
+        case VTLedCommandOff:
+            [device ledsOff];
+            break;
+        case VTLedCommandLuma:
+            [device setLumaMode:v[0]];
+            break;
+    }
+    self.commandsSent++;
+}
+
+@end
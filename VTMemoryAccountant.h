@@ -0,0 +1,90 @@
+//
+//  VTMemoryAccountant.h
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+
+/** Implemented by objects that can report (and optionally reduce) the memory they hold */
+@protocol VTMemoryAccounting <NSObject>
+/** An estimate of the heap bytes currently held for buffered data, records and caches */
+-(NSUInteger) memoryBytesUsed;
+@optional
+/** Releases whatever can be released without losing state that is still in use */
+-(void) trimMemory;
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+/** Keeps a registry of long-lived subsystems and the memory each one holds.
+
+ Subsystems are registered under a name and held weakly, so a subsystem that goes away simply
+ drops out of the report. With a budget set, the accountant checks the total every checkInterval
+ seconds and asks every subsystem to trimMemory while it is over budget, logging when trimming was
+ not enough. The figures are estimates of what each subsystem buffers, not of everything it has
+ allocated. Use it from the main thread.
+ */
+@interface VTMemoryAccountant : NSObject
+
+/** Total bytes the registered subsystems may hold before they are asked to trim (0 for no budget) */
+@property (nonatomic) NSUInteger budget;
+/** Seconds between budget checks while running (default 60) */
+@property (nonatomic) NSTimeInterval checkInterval;
+/** Number of checks that found the total over budget */
+@property (readonly, nonatomic) NSUInteger overBudgetCount;
+
+/** Returns the global shared instance of the VTMemoryAccountant class
+
+ @return The shared accountant
+ */
++(VTMemoryAccountant *) sharedInstance;
+
+/** Registers a subsystem. Registering the same object again replaces its name.
+
+ @param subsystem The subsystem, which is not retained
+ @param name The name it is reported under
+ */
+-(void) registerSubsystem:(NSObject<VTMemoryAccounting> *)subsystem name:(NSString *)name;
+
+/** Unregisters a subsystem
+
+ @param subsystem The subsystem to unregister
+ */
+-(void) unregisterSubsystem:(NSObject<VTMemoryAccounting> *)subsystem;
+
+/** Returns the bytes held by each registered subsystem
+
+ @return NSNumber byte counts keyed by subsystem name (subsystems sharing a name are summed)
+ */
+-(NSDictionary *) bytesBySubsystem;
+
+/** The total bytes held by all registered subsystems */
+@property (readonly, nonatomic) NSUInteger totalBytes;
+
+/** Checks the budget now, trimming every subsystem if the total is over it
+
+ @return YES if the total is within budget afterwards (always YES without a budget)
+ */
+-(BOOL) enforceBudget;
+
+/** Begins checking the budget every checkInterval seconds */
+-(void) start;
+/** Stops the periodic checks */
+-(void) stop;
+@end
@@ -0,0 +1,157 @@
+//
+//  VTMemoryAccountant.m
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "VTMemoryAccountant.h"
+
+// A registration; the subsystem is held weakly so registering never extends its life
+@interface VTMemorySubsystem : NSObject
+@property (weak, nonatomic) NSObject<VTMemoryAccounting> *subsystem;
+@property (copy, nonatomic) NSString *name;
+@end
+
+@implementation VTMemorySubsystem
+@synthesize subsystem, name;
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+@interface VTMemoryAccountant ()
+{
+    NSMutableArray *registrations;
+    NSTimer *checkTimer;
+}
+@property (readwrite, nonatomic) NSUInteger overBudgetCount;
+@end
+
+@implementation VTMemoryAccountant
+
+@synthesize budget;
+@synthesize checkInterval;
+@synthesize overBudgetCount;
+
++(VTMemoryAccountant *) sharedInstance
+{
+    static VTMemoryAccountant *shared = nil;
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        shared = [[VTMemoryAccountant alloc] init];
+    });
+    return shared;
+}
+
+-(id) init
+{
+    self = [super init];
+    if (self) {
+        checkInterval = 60.0;
+        registrations = [[NSMutableArray alloc] init];
+    }
+    return self;
+}
+
+-(void) registerSubsystem:(NSObject<VTMemoryAccounting> *)subsystem name:(NSString *)name
+{
+    if (subsystem == nil) {
+        return;
+    }
+    [self unregisterSubsystem:subsystem];
+
+    VTMemorySubsystem *registration = [[VTMemorySubsystem alloc] init];
+    registration.subsystem = subsystem;
+    registration.name = name;
+    [registrations addObject:registration];
+}
+
+-(void) unregisterSubsystem:(NSObject<VTMemoryAccounting> *)subsystem
+{
+    NSIndexSet *gone = [registrations indexesOfObjectsPassingTest:^BOOL(VTMemorySubsystem *registration, NSUInteger idx, BOOL *stop) {
+        return registration.subsystem == nil || registration.subsystem == subsystem;
+    }];
+    [registrations removeObjectsAtIndexes:gone];
+}
+
+-(NSDictionary *) bytesBySubsystem
+{
+    NSMutableDictionary *bytes = [[NSMutableDictionary alloc] init];
+    for (VTMemorySubsystem *registration in registrations) {
+        NSObject<VTMemoryAccounting> *subsystem = registration.subsystem;
+        if (subsystem == nil) {
+            continue;
+        }
+        NSUInteger total = [[bytes objectForKey:registration.name] unsignedIntegerValue] + [subsystem memoryBytesUsed];
+        [bytes setObject:[NSNumber numberWithUnsignedInteger:total] forKey:registration.name];
+    }
+    return bytes;
+}
+
+-(NSUInteger) totalBytes
+{
+    NSUInteger total = 0;
+    for (VTMemorySubsystem *registration in registrations) {
+        total += [registration.subsystem memoryBytesUsed];
+    }
+    return total;
+}
+
+#pragma mark - Budget
+-(BOOL) enforceBudget
+{
+    // Drop registrations whose subsystem has gone away
+    [self unregisterSubsystem:nil];
+
+    if (budget == 0 || self.totalBytes <= budget) {
+        return YES;
+    }
+    self.overBudgetCount++;
+
+    for (VTMemorySubsystem *registration in [registrations copy]) {
+        NSObject<VTMemoryAccounting> *subsystem = registration.subsystem;
+        if ([subsystem respondsToSelector:@selector(trimMemory)]) {
+            [subsystem trimMemory];
+        }
+    }
+
+    NSUInteger total = self.totalBytes;
+    if (total > budget) {
+        NSLog(@"Memory still over budget after trimming (%lu of %lu bytes): %@", (unsigned long)total, (unsigned long)budget, [self bytesBySubsystem]);
+        return NO;
+    }
+    return YES;
+}
+
+-(void) start
+{
+    [checkTimer invalidate];
+    checkTimer = [NSTimer scheduledTimerWithTimeInterval:checkInterval target:self selector:@selector(check:) userInfo:nil repeats:YES];
+}
+
+-(void) stop
+{
+    [checkTimer invalidate];
+    checkTimer = nil;
+}
+
+-(void) check:(NSTimer *)timer
+{
+    [self enforceBudget];
+}
+
+@end
@@ -0,0 +1,191 @@
+//
+//  VTNodeDeviceHub.h
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "libNode.h"
+#import "VTNodeSample.h"
+#import "VTMemoryAccountant.h"
+
+////////////////////////////////////////////////////////////////////////////////
+/** An immutable batch of samples from a single channel.
+
+ The same batch object is delivered to every subscriber of its channel, so subscribers must not
+ assume they are its only owner.
+ */
+@interface VTSampleBatch : NSObject
+/** The channel every sample in the batch belongs to */
+@property (readonly, nonatomic) VTSampleChannel channel;
+/** The VTNodeSample objects in arrival order */
+@property (readonly, nonatomic) NSArray *samples;
+
+/** Returns a batch
+
+ @param channel The channel of the samples
+ @param samples The samples, which must all belong to channel
+ @return A VTSampleBatch object
+ */
+-(id) initWithChannel:(VTSampleChannel)channel samples:(NSArray *)samples;
+@end
+
+/** Block invoked with each batch a subscription matches */
+typedef void (^VTSampleBatchHandler)(VTSampleBatch *batch);
+
+////////////////////////////////////////////////////////////////////////////////
+/** A registration made with subscribeToChannels:queue:handler:. Pass it to unsubscribe: to stop. */
+@interface VTHubSubscription : NSObject
+/** The channels the subscription receives (a mask of VTSampleChannelMask values) */
+@property (readonly, nonatomic) uint32_t channels;
+/** Batches not delivered because the subscription already had maxPendingBatches queued */
+@property (readonly, nonatomic) unsigned long long droppedBatches;
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+/** A processing step the hub runs on samples between decode and dispatch.
+
+ Stages run on the main thread, in the order they were added, each time a channel is flushed.
+ A stage may drop, hold back, replace or add samples.
+ */
+@protocol VTSampleStage <NSObject>
+/** The channels the stage processes (a mask of VTSampleChannelMask values). Read when the stage is added. */
+-(uint32_t) stageChannels;
+
+/** Processes the samples about to be dispatched for a channel
+
+ @param samples The VTNodeSample objects, in arrival order
+ @param channel The channel being flushed
+ @return The samples to pass on to the next stage (and finally to subscribers)
+ */
+-(NSArray *) stageProcessSamples:(NSArray *)samples channel:(VTSampleChannel)channel;
+
+@optional
+/** Returns how long until the stage next needs to run for a channel, or 0 if it only needs to run
+ when samples arrive.
+
+ Asked after a flush of the channel. The hub flushes the channel again after that long, even if no
+ new samples have arrived (stageProcessSamples:channel: is then passed an empty array), so samples a
+ stage holds back are not stranded when a stream stops.
+
+ @param channel The channel just flushed
+ @return Seconds until the next release, or 0
+ */
+-(NSTimeInterval) stageHoldTimeForChannel:(VTSampleChannel)channel;
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+/** Shares the single delegate slot of each VTNodeDevice between any number of consumers.
+
+ Attached devices send their delegate callbacks to the hub. The hub turns sensor callbacks into
+ VTNodeSample objects and groups them into per-channel VTSampleBatch objects, which are delivered
+ (shared, not copied) to every subscription for that channel on the subscription's queue. Batches
+ are flushed once per pass of the main run loop or when batchSize samples have accumulated.
+
+ Objects that want the classic NodeDeviceDelegate callbacks (connect, disconnect, buttons, module
+ types, and readings) can register with addDelegate: instead; every registered delegate receives
+ every callback it implements (determined once, when the delegate is added). The hub must be used
+ from the main thread.
+ */
+@interface VTNodeDeviceHub : NSObject <NodeDeviceDelegate, VTMemoryAccounting>
+
+/** Maximum samples buffered per channel before a batch is flushed early (default 64) */
+@property (nonatomic) NSUInteger batchSize;
+/** Maximum batches queued but not yet handled per subscription, or 0 for no limit (default 256).
+ Batches for a subscription that is this far behind are dropped and counted in its droppedBatches,
+ so a stalled subscriber cannot make its queue grow without bound. */
+@property (nonatomic) NSUInteger maxPendingBatches;
+/** The devices currently attached */
+@property (readonly, nonatomic) NSArray *attachedDevices;
+
+/** Returns the global shared instance of the VTNodeDeviceHub class.
+ It is registered with the shared VTMemoryAccountant as "hub".
+
+ @return The shared hub
+ */
++(VTNodeDeviceHub *) sharedInstance;
+
+/** Makes the hub the delegate of a device.
+
+ If the device already has a delegate, it is kept as a hub delegate so it continues to receive
+ callbacks. A device is detached again when it disconnects, so anything reconnecting it has to
+ attach it first.
+
+ @param device The device to attach
+ */
+-(void) attachDevice:(VTNodeDevice *)device;
+
+/** Detaches a device. Its delegate is restored to the one it had when attached, which stops
+ being a hub delegate unless it was registered with addDelegate: or is still needed by another device.
+
+ @param device The device to detach
+ */
+-(void) detachDevice:(VTNodeDevice *)device;
+
+/** Registers an object to receive NodeDeviceDelegate callbacks from all attached devices
+
+ @param delegate The object to register. It is retained until removeDelegate: is called.
+ */
+-(void) addDelegate:(NSObject<NodeDeviceDelegate> *)delegate;
+
+/** Unregisters an object added with addDelegate:
+
+ @param delegate The object to unregister
+ */
+-(void) removeDelegate:(NSObject<NodeDeviceDelegate> *)delegate;
+
+/** Subscribes to batches of samples
+
+ @param channels The channels to receive (a mask of VTSampleChannelMask values)
+ @param queue The queue the handler is invoked on (the main queue if NULL)
+ @param handler The block to invoke with each batch
+ @return A subscription to pass to unsubscribe:
+ */
+-(VTHubSubscription *) subscribeToChannels:(uint32_t)channels queue:(dispatch_queue_t)queue handler:(VTSampleBatchHandler)handler;
+
+/** Cancels a subscription. Batches already dispatched may still arrive.
+
+ @param subscription The subscription to cancel
+ */
+-(void) unsubscribe:(VTHubSubscription *)subscription;
+
+/** Adds a processing stage after any existing stages
+
+ @param stage The stage to add
+ */
+-(void) addStage:(NSObject<VTSampleStage> *)stage;
+
+/** Removes a processing stage
+
+ @param stage The stage to remove
+ */
+-(void) removeStage:(NSObject<VTSampleStage> *)stage;
+
+/** Feeds a sample into the hub as if it had arrived from a device.
+
+ The sample keeps its own timestamp, which makes this suitable for replaying recorded sessions or
+ driving the pipeline from a simulator.
+
+ @param sample The sample to inject
+ */
+-(void) injectSample:(VTNodeSample *)sample;
+
+/** Flushes any buffered samples to subscribers immediately */
+-(void) flush;
+@end
@@ -0,0 +1,670 @@
+//
+//  VTNodeDeviceHub.m
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "VTNodeDeviceHub.h"
+#import <libkern/OSAtomic.h>
+#import <objc/runtime.h>
+
+// The NodeDeviceDelegate callbacks the hub forwards, indexing forwardSelectors and forwardLists
+typedef enum {
+    VTHubForwardConnect = 0,
+    VTHubForwardDisconnect,
+    VTHubForwardDataMode,
+    VTHubForwardButtonPushed,
+    VTHubForwardButtonReleased,
+    VTHubForwardModuleTypes,
+    VTHubForwardGyro,
+    VTHubForwardAcc,
+    VTHubForwardMag,
+    VTHubForwardYpr,
+    VTHubForwardQuat,
+    VTHubForwardClimaTemp,
+    VTHubForwardClimaHumidity,
+    VTHubForwardClimaPressure,
+    VTHubForwardClimaLight,
+    VTHubForwardIRThermo,
+    VTHubForwardOxa,
+    VTHubForwardOxaTemp,
+    VTHubForwardVera,
+    VTHubForwardBattery,
+    VTHubForwardCount
+} VTHubForward;
+
+static SEL forwardSelectors[VTHubForwardCount];
+
+// Implementation types of the forwarded callbacks
+typedef void (*VTHubDeviceIMP)(id, SEL, VTNodeDevice *);
+typedef void (*VTHubObjectIMP)(id, SEL, VTNodeDevice *, id);
+typedef void (*VTHubFloatIMP)(id, SEL, VTNodeDevice *, float);
+typedef void (*VTHubDataModeIMP)(id, SEL, VTNodeDevice *, DeviceMode);
+typedef void (*VTHubModuleTypesIMP)(id, SEL, VTNodeDevice *, uint8_t, uint8_t);
+typedef void (*VTHubInt16IMP)(id, SEL, VTNodeDevice *, int16_t);
+
+// Invokes a callback on the delegates that implement it. Who implements what, and the
+// implementations themselves, are resolved when delegates are added, not on every reading.
+#define VT_HUB_FORWARD(callback, imptype, ...) \
+    VTHubForwardList *forwardList = forwardLists[callback]; \
+    for (NSUInteger f = 0; f < forwardList->count; f++) { \
+        ((imptype)forwardList->imps[f])(forwardList->targets[f], forwardSelectors[callback], __VA_ARGS__); \
+    }
+
+@implementation VTSampleBatch
+
+@synthesize channel;
+@synthesize samples;
+
+-(id) initWithChannel:(VTSampleChannel)aChannel samples:(NSArray *)someSamples
+{
+    self = [super init];
+    if (self) {
+        channel = aChannel;
+        samples = someSamples;
+    }
+    return self;
+}
+
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+@interface VTHubSubscription ()
+{
+@public
+    // Batches, and the samples in them, dispatched to the queue but not yet handled
+    volatile int32_t pendingBatches;
+    volatile int32_t pendingSamples;
+}
+@property (readwrite, nonatomic) uint32_t channels;
+@property (readwrite, nonatomic) unsigned long long droppedBatches;
+@property (copy, nonatomic) VTSampleBatchHandler handler;
+@property (nonatomic) dispatch_queue_t queue;
+@property (nonatomic) volatile BOOL cancelled;
+@end
+
+@implementation VTHubSubscription
+
+@synthesize channels;
+@synthesize droppedBatches;
+@synthesize handler;
+@synthesize queue;
+@synthesize cancelled;
+
+-(void) dealloc
+{
+    if (queue) {
+        dispatch_release(queue);
+    }
+}
+
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+// The delegates that implement one callback, with their implementations. Immutable once built.
+@interface VTHubForwardList : NSObject
+{
+@public
+    NSUInteger count;
+    __unsafe_unretained id *targets;
+    IMP *imps;
+}
+// Keeps the targets alive for as long as the list is being iterated
+@property (strong, nonatomic) NSArray *retainedTargets;
+-(id) initWithDelegates:(NSArray *)delegates selector:(SEL)selector;
+@end
+
+@implementation VTHubForwardList
+
+@synthesize retainedTargets;
+
+-(id) initWithDelegates:(NSArray *)delegates selector:(SEL)selector
+{
+    self = [super init];
+    if (self) {
+        NSMutableArray *implementing = [[NSMutableArray alloc] init];
+        for (NSObject<NodeDeviceDelegate> *delegate in delegates) {
+            if ([delegate respondsToSelector:selector]) {
+                [implementing addObject:delegate];
+            }
+        }
+        retainedTargets = [implementing copy];
+        count = [retainedTargets count];
+        targets = (__unsafe_unretained id *)malloc(MAX(count, 1) * sizeof(id));
+        imps = malloc(MAX(count, 1) * sizeof(IMP));
+        for (NSUInteger i = 0; i < count; i++) {
+            NSObject *target = [retainedTargets objectAtIndex:i];
+            targets[i] = target;
+            imps[i] = [target methodForSelector:selector];
+        }
+    }
+    return self;
+}
+
+-(void) dealloc
+{
+    free(targets);
+    free(imps);
+}
+
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+@interface VTNodeDeviceHub ()
+{
+    // Copy-on-write; the arrays themselves are never mutated, so dispatch can iterate them freely
+    NSArray *delegates;
+    NSArray *subscribers;
+    NSArray *subscribersByChannel[VTSampleChannelCount];
+    NSArray *stages;
+    VTHubForwardList *forwardLists[VTHubForwardCount];
+    NSArray *stagesByChannel[VTSampleChannelCount];
+    // Stages implementing stageHoldTimeForChannel:, per channel
+    NSArray *holdingStagesByChannel[VTSampleChannelCount];
+
+    NSMutableArray *pending[VTSampleChannelCount];
+    // Channels with samples in pending, so a flush only visits those
+    uint32_t pendingChannels;
+    BOOL flushScheduled;
+    // Channels with a delayed flush scheduled to release samples held by a stage
+    uint32_t releaseScheduled;
+
+    NSMutableArray *devices;
+    NSMutableDictionary *deviceIDs;
+    // Device -> the delegate it had when attached, for delegates the hub registered on its behalf
+    NSMutableDictionary *priorDelegates;
+}
+@end
+
+@implementation VTNodeDeviceHub
+
+@synthesize batchSize;
+@synthesize maxPendingBatches;
+
++(void) initialize
+{
+    if (self != [VTNodeDeviceHub class]) {
+        return;
+    }
+    forwardSelectors[VTHubForwardConnect] = @selector(nodeDeviceDidConnect:);
+    forwardSelectors[VTHubForwardDisconnect] = @selector(nodeDeviceDidDisconnect:);
+    forwardSelectors[VTHubForwardDataMode] = @selector(nodeDeviceDidUpdateDataMode:withMode:);
+    forwardSelectors[VTHubForwardButtonPushed] = @selector(nodeDeviceButtonPushed:);
+    forwardSelectors[VTHubForwardButtonReleased] = @selector(nodeDeviceButtonReleased:);
+    forwardSelectors[VTHubForwardModuleTypes] = @selector(nodeDeviceDidUpdateModuleTypes:typeA:typeB:);
+    forwardSelectors[VTHubForwardGyro] = @selector(nodeDeviceDidUpdateGyroReading:withReading:);
+    forwardSelectors[VTHubForwardAcc] = @selector(nodeDeviceDidUpdateAccReading:withReading:);
+    forwardSelectors[VTHubForwardMag] = @selector(nodeDeviceDidUpdateMagReading:withReading:);
+    forwardSelectors[VTHubForwardYpr] = @selector(nodeDeviceDidUpdateYprReading:withReading:);
+    forwardSelectors[VTHubForwardQuat] = @selector(nodeDeviceDidUpdateQuatReading:withReading:);
+    forwardSelectors[VTHubForwardClimaTemp] = @selector(nodeDeviceDidUpdateClimaTempReading:withReading:);
+    forwardSelectors[VTHubForwardClimaHumidity] = @selector(nodeDeviceDidUpdateClimaHumidityReading:withReading:);
+    forwardSelectors[VTHubForwardClimaPressure] = @selector(nodeDeviceDidUpdateClimaPressureReading:withReading:);
+    forwardSelectors[VTHubForwardClimaLight] = @selector(nodeDeviceDidUpdateClimaLightReading:withReading:);
+    forwardSelectors[VTHubForwardIRThermo] = @selector(nodeDeviceDidUpdateIRThermoReading:withReading:);
+    forwardSelectors[VTHubForwardOxa] = @selector(nodeDeviceDidUpdateOxaReading:withReading:);
+    forwardSelectors[VTHubForwardOxaTemp] = @selector(nodeDeviceDidUpdateOxaTempReading:withReading:);
+    forwardSelectors[VTHubForwardVera] = @selector(nodeDeviceDidUpdateVeraReading:withReading:);
+    forwardSelectors[VTHubForwardBattery] = @selector(nodeDeviceDidUpdateBatteryLevel:withReading:);
+}
+
++(VTNodeDeviceHub *) sharedInstance
+{
+    static VTNodeDeviceHub *shared = nil;
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        shared = [[VTNodeDeviceHub alloc] init];
+        [[VTMemoryAccountant sharedInstance] registerSubsystem:shared name:@"hub"];
+    });
+    return shared;
+}
+
+-(id) init
+{
+    self = [super init];
+    if (self) {
+        batchSize = 64;
+        maxPendingBatches = 256;
+        delegates = [NSArray array];
+        subscribers = [NSArray array];
+        stages = [NSArray array];
+        devices = [[NSMutableArray alloc] init];
+        deviceIDs = [[NSMutableDictionary alloc] init];
+        priorDelegates = [[NSMutableDictionary alloc] init];
+        for (int ch = 0; ch < VTSampleChannelCount; ch++) {
+            subscribersByChannel[ch] = [NSArray array];
+            stagesByChannel[ch] = [NSArray array];
+            pending[ch] = [[NSMutableArray alloc] init];
+        }
+        [self rebuildForwardLists];
+    }
+    return self;
+}
+
+#pragma mark - Devices
+-(NSArray *) attachedDevices
+{
+    return [devices copy];
+}
+
+-(void) attachDevice:(VTNodeDevice *)device
+{
+    NSValue *key = [NSValue valueWithNonretainedObject:device];
+    NSObject<NodeDeviceDelegate> *prior = device.delegate;
+    if (prior && prior != self) {
+        // Only delegates the hub registered itself are removed again on detach
+        if (![delegates containsObject:prior] || [[priorDelegates allValues] containsObject:prior]) {
+            [priorDelegates setObject:prior forKey:key];
+        }
+        [self addDelegate:prior];
+    }
+    device.delegate = self;
+
+    if (![devices containsObject:device]) {
+        [devices addObject:device];
+        [deviceIDs setObject:[VTNodeSample deviceIDForDevice:device] forKey:key];
+    }
+}
+
+-(void) detachDevice:(VTNodeDevice *)device
+{
+    NSValue *key = [NSValue valueWithNonretainedObject:device];
+    NSObject<NodeDeviceDelegate> *prior = [priorDelegates objectForKey:key];
+    [priorDelegates removeObjectForKey:key];
+    if (prior && ![[priorDelegates allValues] containsObject:prior]) {
+        [self removeDelegate:prior];
+    }
+    if (device.delegate == self) {
+        device.delegate = prior;
+    }
+    [devices removeObject:device];
+    [deviceIDs removeObjectForKey:key];
+}
+
+#pragma mark - Delegates
+-(void) addDelegate:(NSObject<NodeDeviceDelegate> *)delegate
+{
+    if (delegate == nil || delegate == self || [delegates containsObject:delegate]) {
+        return;
+    }
+    delegates = [delegates arrayByAddingObject:delegate];
+    [self rebuildForwardLists];
+}
+
+-(void) removeDelegate:(NSObject<NodeDeviceDelegate> *)delegate
+{
+    NSMutableArray *remaining = [delegates mutableCopy];
+    [remaining removeObject:delegate];
+    delegates = [remaining copy];
+    [self rebuildForwardLists];
+}
+
+-(void) rebuildForwardLists
+{
+    for (int callback = 0; callback < VTHubForwardCount; callback++) {
+        forwardLists[callback] = [[VTHubForwardList alloc] initWithDelegates:delegates selector:forwardSelectors[callback]];
+    }
+}
+
+#pragma mark - Subscriptions
+-(VTHubSubscription *) subscribeToChannels:(uint32_t)channels queue:(dispatch_queue_t)queue handler:(VTSampleBatchHandler)handler
+{
+    VTHubSubscription *subscription = [[VTHubSubscription alloc] init];
+    subscription.channels = channels & VTSampleChannelMaskAll;
+    subscription.handler = handler;
+    subscription.queue = queue ? queue : dispatch_get_main_queue();
+    dispatch_retain(subscription.queue);
+
+    subscribers = [subscribers arrayByAddingObject:subscription];
+    [self rebuildChannelIndex];
+    return subscription;
+}
+
+-(void) unsubscribe:(VTHubSubscription *)subscription
+{
+    subscription.cancelled = YES;
+    NSMutableArray *remaining = [subscribers mutableCopy];
+    [remaining removeObjectIdenticalTo:subscription];
+    subscribers = [remaining copy];
+    [self rebuildChannelIndex];
+}
+
+// Subscribers are indexed per channel so dispatch never has to test filters
+-(void) rebuildChannelIndex
+{
+    for (int ch = 0; ch < VTSampleChannelCount; ch++) {
+        NSMutableArray *matching = [[NSMutableArray alloc] init];
+        for (VTHubSubscription *subscription in subscribers) {
+            if (subscription.channels & VTSampleChannelMask(ch)) {
+                [matching addObject:subscription];
+            }
+        }
+        subscribersByChannel[ch] = [matching copy];
+    }
+}
+
+#pragma mark - Stages
+-(void) addStage:(NSObject<VTSampleStage> *)stage
+{
+    if (stage && ![stages containsObject:stage]) {
+        stages = [stages arrayByAddingObject:stage];
+        [self rebuildStageIndex];
+    }
+}
+
+-(void) removeStage:(NSObject<VTSampleStage> *)stage
+{
+    NSMutableArray *remaining = [stages mutableCopy];
+    [remaining removeObjectIdenticalTo:stage];
+    stages = [remaining copy];
+    [self rebuildStageIndex];
+}
+
+// Stages are indexed per channel, asking each for its channels once rather than on every flush
+-(void) rebuildStageIndex
+{
+    for (int ch = 0; ch < VTSampleChannelCount; ch++) {
+        NSMutableArray *matching = [[NSMutableArray alloc] init];
+        NSMutableArray *holding = [[NSMutableArray alloc] init];
+        for (NSObject<VTSampleStage> *stage in stages) {
+            if ([stage stageChannels] & VTSampleChannelMask(ch)) {
+                [matching addObject:stage];
+                if ([stage respondsToSelector:@selector(stageHoldTimeForChannel:)]) {
+                    [holding addObject:stage];
+                }
+            }
+        }
+        stagesByChannel[ch] = [matching copy];
+        holdingStagesByChannel[ch] = [holding count] ? [holding copy] : nil;
+    }
+}
+
+#pragma mark - Batching
+-(void) addSampleFromDevice:(VTNodeDevice *)device channel:(VTSampleChannel)channel values:(const float *)values
+{
+    if ([subscribersByChannel[channel] count] == 0) {
+        // Nobody is listening; don't allocate a sample
+        return;
+    }
+
+    NSString *deviceID = [deviceIDs objectForKey:[NSValue valueWithNonretainedObject:device]];
+    VTNodeSample *sample = [[VTNodeSample alloc] initWithDevice:device deviceID:deviceID channel:channel timestamp:CFAbsoluteTimeGetCurrent() flags:VTSampleFlagNone values:values];
+    [self enqueueSample:sample];
+}
+
+-(void) injectSample:(VTNodeSample *)sample
+{
+    if ([subscribersByChannel[sample.channel] count] == 0) {
+        return;
+    }
+    [self enqueueSample:sample];
+}
+
+-(void) enqueueSample:(VTNodeSample *)sample
+{
+    VTSampleChannel channel = sample.channel;
+    [pending[channel] addObject:sample];
+    pendingChannels |= VTSampleChannelMask(channel);
+
+    if ([pending[channel] count] >= batchSize) {
+        [self flushChannel:channel];
+    }
+    else if (!flushScheduled) {
+        flushScheduled = YES;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self flush];
+        });
+    }
+}
+
+-(void) flushChannel:(VTSampleChannel)channel
+{
+    pendingChannels &= ~VTSampleChannelMask(channel);
+    NSArray *holdingStages = holdingStagesByChannel[channel];
+    NSArray *samples;
+    if ([pending[channel] count]) {
+        // Hand the buffer itself to the batch and start a new one, rather than copying
+        samples = pending[channel];
+        pending[channel] = [[NSMutableArray alloc] initWithCapacity:batchSize];
+    }
+    else if (holdingStages) {
+        // Nothing new, but a stage may have held samples that are now due
+        samples = [NSArray array];
+    }
+    else {
+        return;
+    }
+
+    NSArray *stageSnapshot = stagesByChannel[channel];
+    for (NSObject<VTSampleStage> *stage in stageSnapshot) {
+        samples = [stage stageProcessSamples:samples channel:channel];
+    }
+    if (holdingStages) {
+        [self scheduleReleaseForChannel:channel stages:holdingStages];
+    }
+    if ([samples count] == 0) {
+        return;
+    }
+
+    VTSampleBatch *batch = [[VTSampleBatch alloc] initWithChannel:channel samples:samples];
+    int32_t count = (int32_t)[samples count];
+
+    for (VTHubSubscription *subscription in subscribersByChannel[channel]) {
+        if (maxPendingBatches && subscription->pendingBatches >= (int32_t)maxPendingBatches) {
+            subscription.droppedBatches++;
+            continue;
+        }
+        OSAtomicIncrement32(&subscription->pendingBatches);
+        OSAtomicAdd32(count, &subscription->pendingSamples);
+        dispatch_async(subscription.queue, ^{
+            if (!subscription.cancelled) {
+                subscription.handler(batch);
+            }
+            OSAtomicAdd32(-count, &subscription->pendingSamples);
+            OSAtomicDecrement32(&subscription->pendingBatches);
+        });
+    }
+}
+
+// Flushes the channel again once the earliest sample held by a stage is due
+-(void) scheduleReleaseForChannel:(VTSampleChannel)channel stages:(NSArray *)holdingStages
+{
+    uint32_t mask = VTSampleChannelMask(channel);
+    if (releaseScheduled & mask) {
+        return;
+    }
+
+    NSTimeInterval due = 0;
+    for (NSObject<VTSampleStage> *stage in holdingStages) {
+        NSTimeInterval hold = [stage stageHoldTimeForChannel:channel];
+        if (hold > 0 && (due == 0 || hold < due)) {
+            due = hold;
+        }
+    }
+    if (due == 0) {
+        return;
+    }
+
+    releaseScheduled |= mask;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(due * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        releaseScheduled &= ~mask;
+        [self flushChannel:channel];
+    });
+}
+
+-(void) flush
+{
+    flushScheduled = NO;
+    while (pendingChannels) {
+        [self flushChannel:(VTSampleChannel)__builtin_ctz(pendingChannels)];
+    }
+}
+
+#pragma mark - Memory Accounting
+-(NSUInteger) memoryBytesUsed
+{
+    NSUInteger samples = 0;
+    for (int ch = 0; ch < VTSampleChannelCount; ch++) {
+        samples += [pending[ch] count];
+    }
+    // Batches are shared between subscriptions, so count the most backlogged one rather than the sum
+    int32_t queued = 0;
+    for (VTHubSubscription *subscription in subscribers) {
+        queued = MAX(queued, subscription->pendingSamples);
+    }
+    // Devices the controller still holds are counted by whoever found them; the hub counts its own
+    // records, and any device it alone keeps alive
+    NSArray *known = [VTNodeController allNodeDevices];
+    NSUInteger records = 0;
+    for (VTNodeDevice *device in devices) {
+        NSString *deviceID = [deviceIDs objectForKey:[NSValue valueWithNonretainedObject:device]];
+        records += class_getInstanceSize([NSValue class]) + [deviceID length] * sizeof(unichar);
+        if (![known containsObject:device]) {
+            records += class_getInstanceSize([VTNodeDevice class]);
+        }
+    }
+    return (samples + queued) * class_getInstanceSize([VTNodeSample class]) + records;
+}
+
+#pragma mark - Node Device Delegate
+-(void) nodeDeviceDidConnect:(VTNodeDevice *)device
+{
+    VT_HUB_FORWARD(VTHubForwardConnect, VTHubDeviceIMP, device);
+}
+
+-(void) nodeDeviceDidDisconnect:(VTNodeDevice *)device
+{
+    VT_HUB_FORWARD(VTHubForwardDisconnect, VTHubDeviceIMP, device);
+    // Whoever reconnects the device attaches it again
+    [self detachDevice:device];
+}
+
+-(void) nodeDeviceDidUpdateDataMode:(VTNodeDevice *)device withMode:(DeviceMode)mode
+{
+    VT_HUB_FORWARD(VTHubForwardDataMode, VTHubDataModeIMP, device, mode);
+}
+
+-(void) nodeDeviceButtonPushed:(VTNodeDevice *)device
+{
+    VT_HUB_FORWARD(VTHubForwardButtonPushed, VTHubDeviceIMP, device);
+}
+
+-(void) nodeDeviceButtonReleased:(VTNodeDevice *)device
+{
+    VT_HUB_FORWARD(VTHubForwardButtonReleased, VTHubDeviceIMP, device);
+}
+
+-(void) nodeDeviceDidUpdateModuleTypes:(VTNodeDevice *)device typeA:(uint8_t)typeA typeB:(uint8_t)typeB
+{
+    VT_HUB_FORWARD(VTHubForwardModuleTypes, VTHubModuleTypesIMP, device, typeA, typeB);
+}
+
+#pragma mark - Node Device Readings
+-(void) nodeDeviceDidUpdateGyroReading:(VTNodeDevice *)device withReading:(VTSensorReading *)reading
+{
+    float v[3] = { reading.x, reading.y, reading.z };
+    [self addSampleFromDevice:device channel:VTSampleChannelGyro values:v];
+    VT_HUB_FORWARD(VTHubForwardGyro, VTHubObjectIMP, device, reading);
+}
+
+-(void) nodeDeviceDidUpdateAccReading:(VTNodeDevice *)device withReading:(VTSensorReading *)reading
+{
+    float v[3] = { reading.x, reading.y, reading.z };
+    [self addSampleFromDevice:device channel:VTSampleChannelAcc values:v];
+    VT_HUB_FORWARD(VTHubForwardAcc, VTHubObjectIMP, device, reading);
+}
+
+-(void) nodeDeviceDidUpdateMagReading:(VTNodeDevice *)device withReading:(VTSensorReading *)reading
+{
+    float v[3] = { reading.x, reading.y, reading.z };
+    [self addSampleFromDevice:device channel:VTSampleChannelMag values:v];
+    VT_HUB_FORWARD(VTHubForwardMag, VTHubObjectIMP, device, reading);
+}
+
+-(void) nodeDeviceDidUpdateYprReading:(VTNodeDevice *)device withReading:(VTYprReading *)reading
+{
+    float v[3] = { reading.yaw, reading.pitch, reading.roll };
+    [self addSampleFromDevice:device channel:VTSampleChannelYpr values:v];
+    VT_HUB_FORWARD(VTHubForwardYpr, VTHubObjectIMP, device, reading);
+}
+
+-(void) nodeDeviceDidUpdateQuatReading:(VTNodeDevice *)device withReading:(VTQuatReading *)reading
+{
+    float v[4] = { reading.q0, reading.q1, reading.q2, reading.q3 };
+    [self addSampleFromDevice:device channel:VTSampleChannelQuat values:v];
+    VT_HUB_FORWARD(VTHubForwardQuat, VTHubObjectIMP, device, reading);
+}
+
+-(void) nodeDeviceDidUpdateClimaTempReading:(VTNodeDevice *)device withReading:(float)reading
+{
+    [self addSampleFromDevice:device channel:VTSampleChannelClimaTemp values:&reading];
+    VT_HUB_FORWARD(VTHubForwardClimaTemp, VTHubFloatIMP, device, reading);
+}
+
+-(void) nodeDeviceDidUpdateClimaHumidityReading:(VTNodeDevice *)device withReading:(float)reading
+{
+    [self addSampleFromDevice:device channel:VTSampleChannelClimaHumidity values:&reading];
+    VT_HUB_FORWARD(VTHubForwardClimaHumidity, VTHubFloatIMP, device, reading);
+}
+
+-(void) nodeDeviceDidUpdateClimaPressureReading:(VTNodeDevice *)device withReading:(float)reading
+{
+    [self addSampleFromDevice:device channel:VTSampleChannelClimaPressure values:&reading];
+    VT_HUB_FORWARD(VTHubForwardClimaPressure, VTHubFloatIMP, device, reading);
+}
+
+-(void) nodeDeviceDidUpdateClimaLightReading:(VTNodeDevice *)device withReading:(float)reading
+{
+    [self addSampleFromDevice:device channel:VTSampleChannelClimaLight values:&reading];
+    VT_HUB_FORWARD(VTHubForwardClimaLight, VTHubFloatIMP, device, reading);
+}
+
+-(void) nodeDeviceDidUpdateIRThermoReading:(VTNodeDevice *)device withReading:(float)reading
+{
+    [self addSampleFromDevice:device channel:VTSampleChannelIRThermo values:&reading];
+    VT_HUB_FORWARD(VTHubForwardIRThermo, VTHubFloatIMP, device, reading);
+}
+
+-(void) nodeDeviceDidUpdateOxaReading:(VTNodeDevice *)device withReading:(float)reading
+{
+    [self addSampleFromDevice:device channel:VTSampleChannelOxa values:&reading];
+    VT_HUB_FORWARD(VTHubForwardOxa, VTHubFloatIMP, device, reading);
+}
+
+-(void) nodeDeviceDidUpdateOxaTempReading:(VTNodeDevice *)device withReading:(int16_t)reading
+{
+    float v = reading;
+    [self addSampleFromDevice:device channel:VTSampleChannelOxaTemp values:&v];
+    VT_HUB_FORWARD(VTHubForwardOxaTemp, VTHubInt16IMP, device, reading);
+}
+
+-(void) nodeDeviceDidUpdateVeraReading:(VTNodeDevice *)device withReading:(VTRGBCReading *)reading
+{
+    float v[4] = { reading.clear, reading.red, reading.green, reading.blue };
+    [self addSampleFromDevice:device channel:VTSampleChannelVera values:v];
+    VT_HUB_FORWARD(VTHubForwardVera, VTHubObjectIMP, device, reading);
+}
+
+-(void) nodeDeviceDidUpdateBatteryLevel:(VTNodeDevice *)device withReading:(float)reading
+{
+    [self addSampleFromDevice:device channel:VTSampleChannelBattery values:&reading];
+    VT_HUB_FORWARD(VTHubForwardBattery, VTHubFloatIMP, device, reading);
+}
+
+@end
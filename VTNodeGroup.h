@@ -0,0 +1,145 @@
+//
+//  VTNodeGroup.h
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "libNode.h"
+#import "VTStreamConfiguration.h"
+
+////////////////////////////////////////////////////////////////////////////////
+/** When one device of a group received a command */
+@interface VTGroupCommandTiming : NSObject
+/** The device */
+@property (weak, readonly, nonatomic) VTNodeDevice *device;
+/** The device identifier (see VTNodeSample deviceID) */
+@property (readonly, nonatomic) NSString *deviceID;
+/** The one-way latency the write was scheduled with, in seconds */
+@property (readonly, nonatomic) NSTimeInterval latency;
+/** YES if latency was measured rather than the group's defaultLatency */
+@property (readonly, nonatomic) BOOL latencyMeasured;
+/** When the write was actually issued, on the CFAbsoluteTime clock */
+@property (readonly, nonatomic) NSTimeInterval issueTime;
+/** When the command is estimated to have taken effect on the device: issueTime + latency */
+@property (readonly, nonatomic) NSTimeInterval estimatedStart;
+/** estimatedStart relative to the group's target time; positive is late */
+@property (readonly, nonatomic) NSTimeInterval offset;
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+/** The outcome of a group command */
+@interface VTGroupCommandReport : NSObject
+/** The shared time the command was meant to take effect, on the CFAbsoluteTime clock */
+@property (readonly, nonatomic) NSTimeInterval targetTime;
+/** A VTGroupCommandTiming for every device, in the group's order */
+@property (readonly, nonatomic) NSArray *timings;
+/** Latest minus earliest estimatedStart, in seconds */
+@property (readonly, nonatomic) NSTimeInterval spread;
+@end
+
+/** Block that sends a command to one device. It is called once per device, and must only
+ issue the command (e.g. [device buzzerBeep:1000]). */
+typedef void (^VTGroupCommandBlock)(VTNodeDevice *device);
+/** Block invoked with the report once every device has been sent the command */
+typedef void (^VTGroupCommandCompletion)(VTGroupCommandReport *report);
+
+////////////////////////////////////////////////////////////////////////////////
+/** Sends commands to several Node devices so that they take effect at the same moment.
+
+ Looping over devices issues each write as soon as the previous one returns, so start times drift
+ apart by each device's link latency. A group instead picks a shared target time a little in the
+ future and issues each device's write at the target minus that device's one-way latency. All
+ writes due in the same instant go out back to back from a single block.
+
+ Node devices have no clock to schedule against, so latency is estimated on the host:
+ estimateLatencyWithCompletion: times requestStatus round trips (to the battery level callback)
+ through the shared VTNodeDeviceHub and takes half of the fastest one. Replies quicker than a BLE
+ connection interval answer an earlier probe and are ignored. Devices without an estimate
+ use defaultLatency. Each command reports when every write was issued and the resulting estimated
+ start-time spread.
+
+ Use it from the main thread.
+ */
+@interface VTNodeGroup : NSObject <NodeDeviceDelegate>
+
+/** The devices in the group */
+@property (readonly, nonatomic) NSArray *devices;
+/** Round trips timed per device by estimateLatencyWithCompletion: (default 5) */
+@property (nonatomic) NSUInteger probeCount;
+/** Seconds to wait for each round trip before giving up on it (default 1) */
+@property (nonatomic) NSTimeInterval probeTimeout;
+/** One-way latency assumed for devices without an estimate (default 0.015, half a typical connection interval) */
+@property (nonatomic) NSTimeInterval defaultLatency;
+/** Smallest delay between sendCommand: and the target time (default 0.1) */
+@property (nonatomic) NSTimeInterval leadTime;
+
+/** Returns a group
+
+ @param devices The VTNodeDevice objects to command together
+ @return A VTNodeGroup object
+ */
+-(id) initWithDevices:(NSArray *)devices;
+
+/** Returns a group of every connected device
+
+ @return A VTNodeGroup of +[VTNodeController allConnectedNodeDevices]
+ */
++(VTNodeGroup *) groupOfConnectedDevices;
+
+/** Measures each device's latency. The devices are attached to the shared hub if they are not already.
+
+ Any other requestStatus issued meanwhile can make a device look faster than it is, so avoid running
+ this while a VTPowerGovernor is polling the same devices.
+
+ @param completion Invoked on the main thread once every device has been probed (may be nil)
+ */
+-(void) estimateLatencyWithCompletion:(void (^)(void))completion;
+
+/** Returns the one-way latency a device's writes are scheduled with
+
+ @param device A device in the group
+ @return The measured latency, or defaultLatency
+ */
+-(NSTimeInterval) latencyForDevice:(VTNodeDevice *)device;
+
+/** Sends a command to every device, to take effect as soon as every device can be reached in time
+
+ @param command The block issuing the command to one device
+ @param completion Invoked on the main thread with the report (may be nil)
+ */
+-(void) sendCommand:(VTGroupCommandBlock)command completion:(VTGroupCommandCompletion)completion;
+
+/** Sends a command to every device, to take effect at a given time
+
+ Devices whose write would already be due are written immediately, and report a late offset.
+
+ @param command The block issuing the command to one device
+ @param targetTime When the command should take effect, on the CFAbsoluteTime clock
+ @param completion Invoked on the main thread with the report (may be nil)
+ */
+-(void) sendCommand:(VTGroupCommandBlock)command atTime:(NSTimeInterval)targetTime completion:(VTGroupCommandCompletion)completion;
+
+/** Applies a stream configuration to every device together
+
+ @param configuration The configuration to apply
+ @param completion Invoked on the main thread with the report (may be nil)
+ */
+-(void) applyConfiguration:(VTStreamConfiguration *)configuration completion:(VTGroupCommandCompletion)completion;
+@end
@@ -0,0 +1,341 @@
+//
+//  VTNodeGroup.m
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "VTNodeGroup.h"
+#import "VTNodeDeviceHub.h"
+#include <math.h>
+
+// Pause between one device's round trips, so a late reply is not mistaken for the next one's
+#define VT_GROUP_PROBE_SPACING      0.05
+// No reply can come back faster than the shortest BLE connection interval; one that does answers an
+// earlier request
+#define VT_GROUP_MIN_ROUND_TRIP     0.0075
+// Writes due within this many seconds of each other go out from the same block
+#define VT_GROUP_BUCKET             0.001
+
+@interface VTGroupCommandTiming ()
+@property (weak, readwrite, nonatomic) VTNodeDevice *device;
+@property (readwrite, nonatomic) NSString *deviceID;
+@property (readwrite, nonatomic) NSTimeInterval latency;
+@property (readwrite, nonatomic) BOOL latencyMeasured;
+@property (readwrite, nonatomic) NSTimeInterval issueTime;
+@property (readwrite, nonatomic) NSTimeInterval offset;
+@end
+
+@implementation VTGroupCommandTiming
+
+@synthesize device, deviceID, latency, latencyMeasured, issueTime, offset;
+
+-(NSTimeInterval) estimatedStart
+{
+    return issueTime + latency;
+}
+
+-(NSString *) description
+{
+    return [NSString stringWithFormat:@"<%@ %@ latency:%.1fms%@ offset:%+.1fms>", NSStringFromClass([self class]),
+            deviceID, latency * 1000, latencyMeasured ? @"" : @" (default)", offset * 1000];
+}
+
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+@interface VTGroupCommandReport ()
+@property (readwrite, nonatomic) NSTimeInterval targetTime;
+@property (readwrite, nonatomic) NSArray *timings;
+@property (readwrite, nonatomic) NSTimeInterval spread;
+@end
+
+@implementation VTGroupCommandReport
+
+@synthesize targetTime, timings, spread;
+
+-(NSString *) description
+{
+    return [NSString stringWithFormat:@"<%@ spread:%.1fms %@>", NSStringFromClass([self class]), spread * 1000, timings];
+}
+
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+// Round-trip probing of one device
+@interface VTGroupProbe : NSObject
+{
+@public
+    NSUInteger remaining;
+    NSUInteger sequence;
+    // When the outstanding requestStatus was sent, or 0 if none is outstanding
+    CFAbsoluteTime sentAt;
+    NSTimeInterval fastest;
+}
+@property (weak, nonatomic) VTNodeDevice *device;
+@end
+
+@implementation VTGroupProbe
+@synthesize device;
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+@interface VTNodeGroup ()
+{
+    // deviceID -> one-way latency
+    NSMutableDictionary *latencies;
+    // deviceID -> VTGroupProbe, for devices still being probed
+    NSMutableDictionary *probes;
+}
+@property (copy, nonatomic) void (^estimateCompletion)(void);
+@end
+
+@implementation VTNodeGroup
+
+@synthesize devices;
+@synthesize probeCount;
+@synthesize probeTimeout;
+@synthesize defaultLatency;
+@synthesize leadTime;
+@synthesize estimateCompletion;
+
++(VTNodeGroup *) groupOfConnectedDevices
+{
+    return [[VTNodeGroup alloc] initWithDevices:[VTNodeController allConnectedNodeDevices]];
+}
+
+-(id) initWithDevices:(NSArray *)someDevices
+{
+    self = [super init];
+    if (self) {
+        devices = [someDevices copy];
+        probeCount = 5;
+        probeTimeout = 1.0;
+        defaultLatency = 0.015;
+        leadTime = 0.1;
+        latencies = [[NSMutableDictionary alloc] init];
+        probes = [[NSMutableDictionary alloc] init];
+    }
+    return self;
+}
+
+-(NSTimeInterval) latencyForDevice:(VTNodeDevice *)device
+{
+    NSNumber *latency = [latencies objectForKey:[VTNodeSample deviceIDForDevice:device]];
+    return latency ? [latency doubleValue] : defaultLatency;
+}
+
+#pragma mark - Latency
+-(void) estimateLatencyWithCompletion:(void (^)(void))completion
+{
+    void (^previous)(void) = self.estimateCompletion;
+    if (previous && completion) {
+        self.estimateCompletion = ^{
+            previous();
+            completion();
+        };
+    }
+    else if (completion) {
+        self.estimateCompletion = completion;
+    }
+    if ([probes count]) {
+        // Already probing; the completion runs when that finishes
+        return;
+    }
+
+    VTNodeDeviceHub *hub = [VTNodeDeviceHub sharedInstance];
+    [hub addDelegate:self];
+    for (VTNodeDevice *device in devices) {
+        [hub attachDevice:device];
+        VTGroupProbe *probe = [[VTGroupProbe alloc] init];
+        probe.device = device;
+        probe->remaining = MAX(probeCount, 1);
+        probe->fastest = INFINITY;
+        [probes setObject:probe forKey:[VTNodeSample deviceIDForDevice:device]];
+    }
+    for (VTGroupProbe *probe in [probes allValues]) {
+        [self sendProbe:probe];
+    }
+    [self finishProbingIfDone];
+}
+
+-(void) sendProbe:(VTGroupProbe *)probe
+{
+    VTNodeDevice *device = probe.device;
+    if (probe->remaining == 0 || device == nil) {
+        [self finishProbe:probe];
+        return;
+    }
+    probe->remaining--;
+    NSUInteger sequence = ++probe->sequence;
+    probe->sentAt = CFAbsoluteTimeGetCurrent();
+    [device requestStatus];
+
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(probeTimeout * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        if (probe->sequence == sequence && probe->sentAt != 0) {
+            // No reply; move on to the next round trip once a late one would have arrived
+            probe->sentAt = 0;
+            [self sendProbeAfterSpacing:probe];
+        }
+    });
+}
+
+-(void) finishProbe:(VTGroupProbe *)probe
+{
+    NSArray *keys = [probes allKeysForObject:probe];
+    if ([keys count] == 0) {
+        return;
+    }
+    if (isfinite(probe->fastest)) {
+        [latencies setObject:[NSNumber numberWithDouble:probe->fastest / 2] forKey:[keys objectAtIndex:0]];
+    }
+    [probes removeObjectsForKeys:keys];
+    [self finishProbingIfDone];
+}
+
+-(void) finishProbingIfDone
+{
+    if ([probes count]) {
+        return;
+    }
+    [[VTNodeDeviceHub sharedInstance] removeDelegate:self];
+
+    void (^done)(void) = self.estimateCompletion;
+    self.estimateCompletion = nil;
+    if (done) {
+        done();
+    }
+}
+
+-(void) nodeDeviceDidUpdateBatteryLevel:(VTNodeDevice *)device withReading:(float)reading
+{
+    VTGroupProbe *probe = [probes objectForKey:[VTNodeSample deviceIDForDevice:device]];
+    if (probe == nil || probe->sentAt == 0) {
+        return;
+    }
+    NSTimeInterval roundTrip = CFAbsoluteTimeGetCurrent() - probe->sentAt;
+    if (roundTrip < VT_GROUP_MIN_ROUND_TRIP) {
+        // A late reply to an earlier probe; keep waiting for this one
+        return;
+    }
+    probe->fastest = MIN(probe->fastest, roundTrip);
+    probe->sentAt = 0;
+    [self sendProbeAfterSpacing:probe];
+}
+
+-(void) sendProbeAfterSpacing:(VTGroupProbe *)probe
+{
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(VT_GROUP_PROBE_SPACING * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        [self sendProbe:probe];
+    });
+}
+
+#pragma mark - Commands
+-(void) sendCommand:(VTGroupCommandBlock)command completion:(VTGroupCommandCompletion)completion
+{
+    NSTimeInterval slowest = 0;
+    for (VTNodeDevice *device in devices) {
+        slowest = MAX(slowest, [self latencyForDevice:device]);
+    }
+    [self sendCommand:command atTime:CFAbsoluteTimeGetCurrent() + MAX(leadTime, slowest + VT_GROUP_BUCKET) completion:completion];
+}
+
+-(void) sendCommand:(VTGroupCommandBlock)command atTime:(NSTimeInterval)targetTime completion:(VTGroupCommandCompletion)completion
+{
+    NSMutableArray *timings = [[NSMutableArray alloc] initWithCapacity:[devices count]];
+    for (VTNodeDevice *device in devices) {
+        NSString *deviceID = [VTNodeSample deviceIDForDevice:device];
+        VTGroupCommandTiming *timing = [[VTGroupCommandTiming alloc] init];
+        timing.device = device;
+        timing.deviceID = deviceID;
+        timing.latencyMeasured = [latencies objectForKey:deviceID] != nil;
+        timing.latency = [self latencyForDevice:device];
+        timing.issueTime = NAN;
+        timing.offset = NAN;
+        [timings addObject:timing];
+    }
+
+    VTGroupCommandReport *report = [[VTGroupCommandReport alloc] init];
+    report.targetTime = targetTime;
+    report.timings = timings;
+    if ([timings count] == 0) {
+        if (completion) {
+            completion(report);
+        }
+        return;
+    }
+
+    // Slowest devices are written first; writes due at (nearly) the same moment share a block
+    NSArray *order = [timings sortedArrayUsingComparator:^NSComparisonResult(VTGroupCommandTiming *a, VTGroupCommandTiming *b) {
+        return a.latency > b.latency ? NSOrderedAscending : (a.latency < b.latency ? NSOrderedDescending : NSOrderedSame);
+    }];
+    NSMutableArray *buckets = [[NSMutableArray alloc] init];
+    for (VTGroupCommandTiming *timing in order) {
+        NSMutableArray *bucket = [buckets lastObject];
+        if (bucket == nil || [[bucket objectAtIndex:0] latency] - timing.latency >= VT_GROUP_BUCKET) {
+            bucket = [[NSMutableArray alloc] init];
+            [buckets addObject:bucket];
+        }
+        [bucket addObject:timing];
+    }
+
+    __block NSUInteger remaining = [buckets count];
+    CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+    for (NSArray *bucket in buckets) {
+        NSTimeInterval due = targetTime - [[bucket objectAtIndex:0] latency];
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(MAX(due - now, 0) * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+            for (VTGroupCommandTiming *timing in bucket) {
+                VTNodeDevice *device = timing.device;
+                if (device == nil) {
+                    continue;
+                }
+                timing.issueTime = CFAbsoluteTimeGetCurrent();
+                command(device);
+                timing.offset = timing.estimatedStart - targetTime;
+            }
+            if (--remaining == 0) {
+                [self finishReport:report completion:completion];
+            }
+        });
+    }
+}
+
+-(void) finishReport:(VTGroupCommandReport *)report completion:(VTGroupCommandCompletion)completion
+{
+    NSTimeInterval earliest = INFINITY, latest = -INFINITY;
+    for (VTGroupCommandTiming *timing in report.timings) {
+        if (!isnan(timing.issueTime)) {
+            earliest = MIN(earliest, timing.estimatedStart);
+            latest = MAX(latest, timing.estimatedStart);
+        }
+    }
+    report.spread = latest >= earliest ? latest - earliest : 0;
+    if (completion) {
+        completion(report);
+    }
+}
+
+-(void) applyConfiguration:(VTStreamConfiguration *)configuration completion:(VTGroupCommandCompletion)completion
+{
+    VTStreamConfiguration *snapshot = [configuration copy];
+    [self sendCommand:^(VTNodeDevice *device) {
+        [snapshot applyToDevice:device];
+    } completion:completion];
+}
+
+@end
@@ -0,0 +1,121 @@
+//
+//  VTNodeSample.h
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "libNode.h"
+
+/** The data channels a Node device can report */
+typedef enum {
+    VTSampleChannelAcc = 0,
+    VTSampleChannelGyro,
+    VTSampleChannelMag,
+    VTSampleChannelQuat,
+    VTSampleChannelYpr,
+    VTSampleChannelClimaTemp,
+    VTSampleChannelClimaHumidity,
+    VTSampleChannelClimaPressure,
+    VTSampleChannelClimaLight,
+    VTSampleChannelIRThermo,
+    VTSampleChannelOxa,
+    VTSampleChannelOxaTemp,
+    VTSampleChannelVera,
+    VTSampleChannelBattery,
+    VTSampleChannelCount
+} VTSampleChannel;
+
+/** Bit mask for a single channel, for APIs that take a set of channels */
+#define VTSampleChannelMask(channel)    (1u << (channel))
+#define VTSampleChannelMaskAll          ((1u << VTSampleChannelCount) - 1)
+#define VTSampleChannelMaskKore         (VTSampleChannelMask(VTSampleChannelAcc) | VTSampleChannelMask(VTSampleChannelGyro) | VTSampleChannelMask(VTSampleChannelMag))
+
+/** Flags attached to a sample */
+enum {
+    VTSampleFlagNone = 0,
+    /** The sample was synthesized to fill a gap in the stream */
+    VTSampleFlagInterpolated = 1 << 0,
+    /** Host-side calibration corrections have been applied to the values */
+    VTSampleFlagCalibrated = 1 << 1
+};
+typedef uint8_t VTSampleFlags;
+
+////////////////////////////////////////////////////////////////////////////////
+/** An immutable, timestamped reading from one channel of a Node device.
+
+ Three-axis readings use x, y and z; quaternions use x..w for q0..q3; Vera readings use x..w for
+ clear, red, green and blue; every other channel is a single value in x.
+ */
+@interface VTNodeSample : NSObject
+
+/** The device that produced the sample (nil once the device has been released) */
+@property (weak, readonly, nonatomic) VTNodeDevice *device;
+/** A stable identifier for the device (its peripheral UUID) */
+@property (readonly, nonatomic) NSString *deviceID;
+/** The channel the sample belongs to */
+@property (readonly, nonatomic) VTSampleChannel channel;
+/** When the sample was received, in seconds since the reference date */
+@property (readonly, nonatomic) NSTimeInterval timestamp;
+/** Flags describing how the sample was produced */
+@property (readonly, nonatomic) VTSampleFlags flags;
+@property (readonly, nonatomic) float x;
+@property (readonly, nonatomic) float y;
+@property (readonly, nonatomic) float z;
+@property (readonly, nonatomic) float w;
+
+/** Returns the number of values used by a channel (1, 3 or 4)
+
+ @param channel The channel
+ @return The number of values
+ */
++(NSUInteger) valueCountForChannel:(VTSampleChannel)channel;
+
+/** Returns a short name for a channel, e.g. "acc" or "clima.temp"
+
+ @param channel The channel
+ @return The name
+ */
++(NSString *) nameForChannel:(VTSampleChannel)channel;
+
+/** Returns the identifier used for a device in deviceID
+
+ @param device The device
+ @return The device's peripheral UUID as a string
+ */
++(NSString *) deviceIDForDevice:(VTNodeDevice *)device;
+
+/** Returns a sample
+
+ @param device The device that produced the sample
+ @param deviceID The identifier of the device (pass nil to derive it from device)
+ @param channel The channel
+ @param timestamp When the sample was received
+ @param flags Flags describing the sample
+ @param values valueCountForChannel: values
+ @return A VTNodeSample object
+ */
+-(id) initWithDevice:(VTNodeDevice *)device deviceID:(NSString *)deviceID channel:(VTSampleChannel)channel timestamp:(NSTimeInterval)timestamp flags:(VTSampleFlags)flags values:(const float *)values;
+
+/** Copies the sample's values into a buffer of at least valueCountForChannel: floats
+
+ @param values The buffer to fill
+ */
+-(void) getValues:(float *)values;
+@end
@@ -0,0 +1,111 @@
+//
+//  VTNodeSample.m
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "VTNodeSample.h"
+
+@implementation VTNodeSample
+{
+    float values[4];
+}
+
+@synthesize device;
+@synthesize deviceID;
+@synthesize channel;
+@synthesize timestamp;
+@synthesize flags;
+
++(NSUInteger) valueCountForChannel:(VTSampleChannel)channel
+{
+    switch (channel) {
+        case VTSampleChannelAcc:
+        case VTSampleChannelGyro:
+        case VTSampleChannelMag:
+        case VTSampleChannelYpr:
+            return 3;
+        case VTSampleChannelQuat:
+        case VTSampleChannelVera:
+            return 4;
+        default:
+            return 1;
+    }
+}
+
++(NSString *) nameForChannel:(VTSampleChannel)channel
+{
+    switch (channel) {
+        case VTSampleChannelAcc:            return @"acc";
+        case VTSampleChannelGyro:           return @"gyro";
+        case VTSampleChannelMag:            return @"mag";
+        case VTSampleChannelQuat:           return @"quat";
+        case VTSampleChannelYpr:            return @"ypr";
+        case VTSampleChannelClimaTemp:      return @"clima.temp";
+        case VTSampleChannelClimaHumidity:  return @"clima.humidity";
+        case VTSampleChannelClimaPressure:  return @"clima.pressure";
+        case VTSampleChannelClimaLight:     return @"clima.light";
+        case VTSampleChannelIRThermo:       return @"therma";
+        case VTSampleChannelOxa:            return @"oxa";
+        case VTSampleChannelOxaTemp:        return @"oxa.temp";
+        case VTSampleChannelVera:           return @"vera";
+        case VTSampleChannelBattery:        return @"battery";
+        default:                            return @"unknown";
+    }
+}
+
++(NSString *) deviceIDForDevice:(VTNodeDevice *)device
+{
+    CFUUIDRef uuid = device.peripheral.UUID;
+    if (uuid == NULL) {
+        return [NSString stringWithFormat:@"%p", device];
+    }
+    return (__bridge_transfer NSString *)CFUUIDCreateString(NULL, uuid);
+}
+
+-(id) initWithDevice:(VTNodeDevice *)aDevice deviceID:(NSString *)anID channel:(VTSampleChannel)aChannel timestamp:(NSTimeInterval)aTimestamp flags:(VTSampleFlags)someFlags values:(const float *)someValues
+{
+    self = [super init];
+    if (self) {
+        device = aDevice;
+        deviceID = anID ? [anID copy] : [VTNodeSample deviceIDForDevice:aDevice];
+        channel = aChannel;
+        timestamp = aTimestamp;
+        flags = someFlags;
+        memcpy(values, someValues, [VTNodeSample valueCountForChannel:aChannel] * sizeof(float));
+    }
+    return self;
+}
+
+-(float) x { return values[0]; }
+-(float) y { return values[1]; }
+-(float) z { return values[2]; }
+-(float) w { return values[3]; }
+
+-(void) getValues:(float *)out
+{
+    memcpy(out, values, [VTNodeSample valueCountForChannel:channel] * sizeof(float));
+}
+
+-(NSString *) description
+{
+    return [NSString stringWithFormat:@"<%@ %@ %@ %.3f: %f %f %f %f>", NSStringFromClass([self class]), deviceID, [VTNodeSample nameForChannel:channel], timestamp, values[0], values[1], values[2], values[3]];
+}
+
+@end
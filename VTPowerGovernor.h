@@ -0,0 +1,139 @@
+//
+//  VTPowerGovernor.h
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "libNode.h"
+#import "VTStreamConfiguration.h"
+#import "VTReconnectSupervisor.h"
+
+/** Actions the power governor can take, in the order it tries them */
+typedef enum {
+    VTPowerActionDisableThermaLed = 0,
+    VTPowerActionDisableLeds,
+    VTPowerActionDisableLuma,
+    VTPowerActionSlowKore,
+    VTPowerActionSlowEnvironmental,
+    VTPowerActionDisableOrientation,
+    /** The app applied a new configuration, replacing any reductions */
+    VTPowerActionRestore
+} VTPowerAction;
+
+////////////////////////////////////////////////////////////////////////////////
+/** Describes a single change the power governor made to a device */
+@interface VTPowerDecision : NSObject
+/** The action taken */
+@property (readonly, nonatomic) VTPowerAction action;
+/** The battery level (0-1) when the decision was made */
+@property (readonly, nonatomic) float batteryLevel;
+/** Predicted remaining runtime in seconds before the change */
+@property (readonly, nonatomic) NSTimeInterval predictedRuntimeBefore;
+/** Predicted remaining runtime in seconds after the change */
+@property (readonly, nonatomic) NSTimeInterval predictedRuntimeAfter;
+/** The configuration sent to the device */
+@property (readonly, nonatomic) VTStreamConfiguration *configuration;
+@end
+
+@class VTPowerGovernor;
+
+/** Delegate protocol for the VTPowerGovernor class */
+@protocol VTPowerGovernorDelegate <NSObject>
+@optional
+/** Invoked each time the governor changes the device configuration
+
+ @param governor The governor that made the change
+ @param decision The change that was made
+ */
+-(void) powerGovernor:(VTPowerGovernor *)governor didApplyDecision:(VTPowerDecision *)decision;
+
+/** Invoked each time a new battery sample has been taken into account
+
+ @param governor The governor that took the sample
+ @param runtime The predicted remaining runtime in seconds (negative until enough samples exist)
+ */
+-(void) powerGovernor:(VTPowerGovernor *)governor didUpdatePredictedRuntime:(NSTimeInterval)runtime;
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+/** Keeps a Node device's streams within a battery budget for a target session duration.
+
+ The governor polls the battery level with requestStatus at a low rate, fits the observed drain
+ against a load model of the active streams and LEDs, and steps the device down (LEDs off, longer
+ periods, orientation off) whenever the predicted runtime falls short of the target.
+
+ While running, the governor receives battery levels through the shared VTNodeDeviceHub, attaching
+ the device to it. Only the commands a reduction changes are sent. If the device is also watched by
+ a VTReconnectSupervisor, set supervisor so a reconnect restores the reduced configuration rather
+ than the original one.
+ */
+@interface VTPowerGovernor : NSObject <NodeDeviceDelegate>
+
+/** The delegate object you want to receive governor decisions */
+@property (weak, nonatomic) NSObject<VTPowerGovernorDelegate> *delegate;
+/** The device being governed */
+@property (readonly, nonatomic) VTNodeDevice *device;
+/** A supervisor whose configuration is kept equal to appliedConfiguration (may be nil) */
+@property (weak, nonatomic) VTReconnectSupervisor *supervisor;
+/** How long the session should last, measured from start (default 8 hours) */
+@property (nonatomic) NSTimeInterval targetSessionDuration;
+/** Seconds between battery requests (default 60) */
+@property (nonatomic) NSTimeInterval sampleInterval;
+/** The configuration the app asked for */
+@property (readonly, nonatomic) VTStreamConfiguration *requestedConfiguration;
+/** The configuration currently applied to the device, after any reductions */
+@property (readonly, nonatomic) VTStreamConfiguration *appliedConfiguration;
+/** The predicted remaining runtime in seconds, or a negative value until enough samples exist */
+@property (readonly, nonatomic) NSTimeInterval predictedRuntime;
+/** True between start and stop */
+@property (readonly, nonatomic) bool isRunning;
+
+/** Returns a governor for the given device
+
+ @param device The device to govern
+ @return A VTPowerGovernor object
+ */
+-(id) initWithDevice:(VTNodeDevice *)device;
+
+/** Registers with the shared VTNodeDeviceHub and starts sampling the battery and governing the device */
+-(void) start;
+/** Stops sampling and unregisters from the hub. The device keeps its current configuration. */
+-(void) stop;
+
+/** Applies a configuration to the device, replacing any reductions made so far
+
+ @param configuration The configuration the app wants
+ */
+-(void) applyConfiguration:(VTStreamConfiguration *)configuration;
+
+/** Estimated relative power draw of a configuration (1.0 == KORE acc at 20ms)
+
+ @param configuration The configuration to estimate
+ @return The modelled load
+ */
++(double) loadForConfiguration:(VTStreamConfiguration *)configuration;
+
+/** Takes a battery level of the governed device into account. Called for each
+ nodeDeviceDidUpdateBatteryLevel while running; it can also be fed recorded levels.
+
+ @param reading The battery level between 0 and 1
+ */
+-(void) deviceDidUpdateBatteryLevel:(float)reading;
+@end
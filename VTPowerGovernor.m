@@ -0,0 +1,391 @@
+//
+//  VTPowerGovernor.m
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "VTPowerGovernor.h"
+#import "VTNodeDeviceHub.h"
+
+#define VT_GOVERNOR_MAX_SAMPLES     32
+#define VT_GOVERNOR_MIN_SAMPLES     3
+#define VT_GOVERNOR_MIN_SPAN        300.0   // seconds of history before predicting
+#define VT_GOVERNOR_BASE_LOAD       0.5     // connected, nothing streaming
+
+// Slowest periods the governor will step down to (10ms units)
+#define VT_GOVERNOR_MAX_KORE_PERIOD     50
+#define VT_GOVERNOR_MAX_CLIMA_PERIOD    400
+#define VT_GOVERNOR_MAX_THERMA_PERIOD   100
+#define VT_GOVERNOR_MAX_OXA_PERIOD      1000
+
+// Doubles a period towards the slowest allowed. A period of 0 becomes 1, so every step changes the
+// configuration and govern's loop always makes progress.
+static uint16_t VTSlowerPeriod(uint16_t period, uint16_t slowest)
+{
+    return MIN(MAX(period * 2, 1), slowest);
+}
+
+@interface VTPowerDecision ()
+@property (readwrite, nonatomic) VTPowerAction action;
+@property (readwrite, nonatomic) float batteryLevel;
+@property (readwrite, nonatomic) NSTimeInterval predictedRuntimeBefore;
+@property (readwrite, nonatomic) NSTimeInterval predictedRuntimeAfter;
+@property (readwrite, nonatomic) VTStreamConfiguration *configuration;
+@end
+
+@implementation VTPowerDecision
+@synthesize action, batteryLevel, predictedRuntimeBefore, predictedRuntimeAfter, configuration;
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+@interface VTPowerGovernor ()
+{
+    NSTimeInterval sampleTime[VT_GOVERNOR_MAX_SAMPLES];
+    float sampleLevel[VT_GOVERNOR_MAX_SAMPLES];
+    int sampleCount;
+    int sampleNext;
+    // Battery fraction drained per second per unit of modelled load, or 0 if unknown
+    double unitDrain;
+    NSTimeInterval startTime;
+    float lastLevel;
+}
+@property (strong, nonatomic) NSTimer *sampleTimer;
+@property (readwrite, nonatomic) VTStreamConfiguration *requestedConfiguration;
+@property (readwrite, nonatomic) VTStreamConfiguration *appliedConfiguration;
+@end
+
+@implementation VTPowerGovernor
+
+@synthesize delegate;
+@synthesize device;
+@synthesize supervisor;
+@synthesize targetSessionDuration;
+@synthesize sampleInterval;
+@synthesize requestedConfiguration;
+@synthesize appliedConfiguration;
+@synthesize sampleTimer;
+
+-(id) initWithDevice:(VTNodeDevice *)aDevice
+{
+    self = [super init];
+    if (self) {
+        device = aDevice;
+        targetSessionDuration = 8 * 60 * 60;
+        sampleInterval = 60;
+        requestedConfiguration = [[VTStreamConfiguration alloc] init];
+        appliedConfiguration = [requestedConfiguration copy];
+        lastLevel = -1;
+    }
+    return self;
+}
+
+-(void) dealloc
+{
+    [sampleTimer invalidate];
+}
+
+-(bool) isRunning
+{
+    return self.sampleTimer != nil;
+}
+
+#pragma mark - Control
+-(void) start
+{
+    if (self.sampleTimer) {
+        return;
+    }
+    startTime = [NSDate timeIntervalSinceReferenceDate];
+    VTNodeDeviceHub *hub = [VTNodeDeviceHub sharedInstance];
+    [hub attachDevice:self.device];
+    [hub addDelegate:self];
+    self.sampleTimer = [NSTimer scheduledTimerWithTimeInterval:self.sampleInterval target:self selector:@selector(sampleTimerFired:) userInfo:nil repeats:YES];
+    [self.device requestStatus];
+}
+
+-(void) stop
+{
+    [self.sampleTimer invalidate];
+    self.sampleTimer = nil;
+    [[VTNodeDeviceHub sharedInstance] removeDelegate:self];
+}
+
+-(void) sampleTimerFired:(NSTimer *)timer
+{
+    [self.device requestStatus];
+}
+
+-(void) applyConfiguration:(VTStreamConfiguration *)configuration
+{
+    VTStreamConfiguration *previous = self.appliedConfiguration;
+    self.requestedConfiguration = [configuration copy];
+    self.appliedConfiguration = [configuration copy];
+    [self.appliedConfiguration applyToDevice:self.device previous:previous];
+    self.supervisor.configuration = self.appliedConfiguration;
+    [self resetSamples];
+
+    if ([self.delegate respondsToSelector:@selector(powerGovernor:didApplyDecision:)]) {
+        VTPowerDecision *decision = [[VTPowerDecision alloc] init];
+        decision.action = VTPowerActionRestore;
+        decision.batteryLevel = lastLevel;
+        decision.predictedRuntimeBefore = -1;
+        decision.predictedRuntimeAfter = self.predictedRuntime;
+        decision.configuration = [configuration copy];
+        [self.delegate powerGovernor:self didApplyDecision:decision];
+    }
+}
+
+#pragma mark - Load Model
+// Relative draw of each feature at its default rate. Rates scale linearly with 1/period.
++(double) loadForConfiguration:(VTStreamConfiguration *)c
+{
+    double load = 0;
+
+    int koreStreams = (c.koreAcc ? 1 : 0) + (c.koreGyro ? 1 : 0) + (c.koreMag ? 1 : 0);
+    if (koreStreams > 0) {
+        load += koreStreams * 1.0 * (2.0 / MAX(c.korePeriod, 1));
+    }
+    if (c.oriYpr || c.oriQuat) {
+        // Fusion keeps all three KORE sensors running at 10ms
+        load += 3.0;
+    }
+    if (c.climaTempPressure || c.climaHumidity || c.climaLightProximity) {
+        load += 0.2 * (25.0 / MAX(c.climaPeriod, 1));
+    }
+    if (c.irThermo) {
+        load += 0.3 * (10.0 / MAX(c.irThermoPeriod, 1));
+        if (c.irThermoLed) {
+            load += 1.5;
+        }
+    }
+    if (c.oxa) {
+        load += 0.5 * (100.0 / MAX(c.oxaPeriod, 1));
+    }
+
+    int lumaLeds = 0;
+    for (uint8_t m = c.lumaMode; m; m >>= 1) {
+        lumaLeds += m & 1;
+    }
+    load += lumaLeds * 0.4;
+    load += (c.ledABlue + c.ledBBlue + c.ledARed + c.ledBRed) / 255.0 * 0.5;
+
+    return load;
+}
+
+-(NSTimeInterval) runtimeForConfiguration:(VTStreamConfiguration *)configuration
+{
+    if (unitDrain <= 0 || lastLevel < 0) {
+        return -1;
+    }
+    double load = VT_GOVERNOR_BASE_LOAD + [VTPowerGovernor loadForConfiguration:configuration];
+    return lastLevel / (unitDrain * load);
+}
+
+-(NSTimeInterval) predictedRuntime
+{
+    return [self runtimeForConfiguration:self.appliedConfiguration];
+}
+
+#pragma mark - Battery Samples
+-(void) resetSamples
+{
+    // The drain estimate survives a configuration change; only the history used to refit it is cleared
+    sampleCount = 0;
+    sampleNext = 0;
+}
+
+-(void) deviceDidUpdateBatteryLevel:(float)reading
+{
+    NSTimeInterval now = [NSDate timeIntervalSinceReferenceDate];
+    lastLevel = reading;
+
+    sampleTime[sampleNext] = now;
+    sampleLevel[sampleNext] = reading;
+    sampleNext = (sampleNext + 1) % VT_GOVERNOR_MAX_SAMPLES;
+    if (sampleCount < VT_GOVERNOR_MAX_SAMPLES) {
+        sampleCount++;
+    }
+
+    [self refitDrain];
+
+    NSTimeInterval runtime = self.predictedRuntime;
+    if ([self.delegate respondsToSelector:@selector(powerGovernor:didUpdatePredictedRuntime:)]) {
+        [self.delegate powerGovernor:self didUpdatePredictedRuntime:runtime];
+    }
+
+    if (self.isRunning) {
+        [self govern];
+    }
+}
+
+-(void) nodeDeviceDidUpdateBatteryLevel:(VTNodeDevice *)aDevice withReading:(float)reading
+{
+    if (aDevice == self.device) {
+        [self deviceDidUpdateBatteryLevel:reading];
+    }
+}
+
+// Least-squares slope of battery level over time, normalized by the modelled load
+-(void) refitDrain
+{
+    if (sampleCount < VT_GOVERNOR_MIN_SAMPLES) {
+        return;
+    }
+
+    int first = (sampleNext - sampleCount + VT_GOVERNOR_MAX_SAMPLES) % VT_GOVERNOR_MAX_SAMPLES;
+    NSTimeInterval t0 = sampleTime[first];
+    double sumT = 0, sumL = 0, sumTT = 0, sumTL = 0, span = 0;
+    for (int i = 0; i < sampleCount; i++) {
+        int idx = (first + i) % VT_GOVERNOR_MAX_SAMPLES;
+        double t = sampleTime[idx] - t0;
+        double l = sampleLevel[idx];
+        sumT += t;
+        sumL += l;
+        sumTT += t * t;
+        sumTL += t * l;
+        span = t;
+    }
+    if (span < VT_GOVERNOR_MIN_SPAN) {
+        return;
+    }
+
+    double n = sampleCount;
+    double denominator = n * sumTT - sumT * sumT;
+    if (denominator <= 0) {
+        return;
+    }
+    double slope = (n * sumTL - sumT * sumL) / denominator;
+    if (slope >= 0) {
+        // Charging, or too coarse to see any drain yet
+        return;
+    }
+
+    double load = VT_GOVERNOR_BASE_LOAD + [VTPowerGovernor loadForConfiguration:self.appliedConfiguration];
+    unitDrain = -slope / load;
+}
+
+#pragma mark - Governing
+// Returns YES if the action changed the configuration
+-(BOOL) applyAction:(VTPowerAction)action to:(VTStreamConfiguration *)c
+{
+    switch (action) {
+        case VTPowerActionDisableThermaLed:
+            if (c.irThermo && c.irThermoLed) {
+                c.irThermoLed = false;
+                return YES;
+            }
+            return NO;
+        case VTPowerActionDisableLeds:
+            if (c.ledABlue || c.ledBBlue || c.ledARed || c.ledBRed) {
+                c.ledABlue = c.ledBBlue = c.ledARed = c.ledBRed = 0;
+                return YES;
+            }
+            return NO;
+        case VTPowerActionDisableLuma:
+            if (c.lumaMode) {
+                c.lumaMode = 0;
+                return YES;
+            }
+            return NO;
+        case VTPowerActionSlowKore:
+            if ((c.koreAcc || c.koreGyro || c.koreMag) && c.korePeriod < VT_GOVERNOR_MAX_KORE_PERIOD) {
+                c.korePeriod = VTSlowerPeriod(c.korePeriod, VT_GOVERNOR_MAX_KORE_PERIOD);
+                return YES;
+            }
+            return NO;
+        case VTPowerActionSlowEnvironmental: {
+            BOOL changed = NO;
+            if ((c.climaTempPressure || c.climaHumidity || c.climaLightProximity) && c.climaPeriod < VT_GOVERNOR_MAX_CLIMA_PERIOD) {
+                c.climaPeriod = VTSlowerPeriod(c.climaPeriod, VT_GOVERNOR_MAX_CLIMA_PERIOD);
+                changed = YES;
+            }
+            if (c.irThermo && c.irThermoPeriod < VT_GOVERNOR_MAX_THERMA_PERIOD) {
+                c.irThermoPeriod = VTSlowerPeriod(c.irThermoPeriod, VT_GOVERNOR_MAX_THERMA_PERIOD);
+                changed = YES;
+            }
+            if (c.oxa && c.oxaPeriod < VT_GOVERNOR_MAX_OXA_PERIOD) {
+                c.oxaPeriod = VTSlowerPeriod(c.oxaPeriod, VT_GOVERNOR_MAX_OXA_PERIOD);
+                changed = YES;
+            }
+            return changed;
+        }
+        case VTPowerActionDisableOrientation:
+            if (c.oriYpr || c.oriQuat) {
+                c.oriYpr = c.oriQuat = false;
+                return YES;
+            }
+            return NO;
+        default:
+            return NO;
+    }
+}
+
+-(void) govern
+{
+    NSTimeInterval runtime = self.predictedRuntime;
+    if (runtime < 0) {
+        return;
+    }
+
+    NSTimeInterval elapsed = [NSDate timeIntervalSinceReferenceDate] - startTime;
+    NSTimeInterval needed = self.targetSessionDuration - elapsed;
+
+    VTStreamConfiguration *working = [self.appliedConfiguration copy];
+    NSMutableArray *decisions = [[NSMutableArray alloc] init];
+
+    while (runtime < needed) {
+        // Always take the cheapest remaining step first; slowing a stream can repeat until it bottoms out
+        VTPowerAction action;
+        for (action = VTPowerActionDisableThermaLed; action < VTPowerActionRestore; action++) {
+            if ([self applyAction:action to:working]) {
+                break;
+            }
+        }
+        if (action == VTPowerActionRestore) {
+            break;
+        }
+
+        VTPowerDecision *decision = [[VTPowerDecision alloc] init];
+        decision.action = action;
+        decision.batteryLevel = lastLevel;
+        decision.predictedRuntimeBefore = runtime;
+        runtime = [self runtimeForConfiguration:working];
+        decision.predictedRuntimeAfter = runtime;
+        decision.configuration = [working copy];
+        [decisions addObject:decision];
+    }
+
+    if ([decisions count] == 0) {
+        return;
+    }
+
+    NSLog(@"Power governor: %lu reductions, predicted runtime %.0fs for %.0fs remaining", (unsigned long)[decisions count], runtime, needed);
+    [working applyToDevice:self.device previous:self.appliedConfiguration];
+    self.appliedConfiguration = working;
+    self.supervisor.configuration = working;
+    [self resetSamples];
+
+    if ([self.delegate respondsToSelector:@selector(powerGovernor:didApplyDecision:)]) {
+        for (VTPowerDecision *decision in decisions) {
+            [self.delegate powerGovernor:self didApplyDecision:decision];
+        }
+    }
+}
+
+@end
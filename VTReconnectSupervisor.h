@@ -0,0 +1,150 @@
+//
+//  VTReconnectSupervisor.h
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "libNode.h"
+#import "VTStreamConfiguration.h"
+
+/** Where a VTReconnectSupervisor is in its recovery cycle */
+typedef enum {
+    /** Not started, stopped, or gave up */
+    VTReconnectStateIdle = 0,
+    /** The device is connected and its streams have been restored */
+    VTReconnectStateConnected,
+    /** Waiting for the next attempt or for an attempt to complete */
+    VTReconnectStateReconnecting,
+    /** Reconnected and waiting for the device to accept commands before replaying its configuration */
+    VTReconnectStateRestoring
+} VTReconnectState;
+
+@class VTReconnectSupervisor;
+
+/** Delegate protocol for the VTReconnectSupervisor class */
+@protocol VTReconnectSupervisorDelegate <NSObject>
+@optional
+/** Invoked before each reconnection attempt is scheduled
+
+ @param supervisor The supervisor
+ @param attempt The attempt number, starting at 1
+ @param delay Seconds until the attempt is made
+ */
+-(void) reconnectSupervisor:(VTReconnectSupervisor *)supervisor willAttempt:(NSUInteger)attempt afterDelay:(NSTimeInterval)delay;
+
+/** Invoked once the device is reconnected and its configuration has been replayed
+
+ @param supervisor The supervisor
+ @param seconds Time from the disconnect to the replay
+ @param attempts The number of attempts it took
+ */
+-(void) reconnectSupervisor:(VTReconnectSupervisor *)supervisor didRecoverAfter:(NSTimeInterval)seconds attempts:(NSUInteger)attempts;
+
+/** Invoked when maxAttempts attempts have failed. The supervisor is idle afterwards and no longer
+ watches the device; call start to supervise it again.
+
+ @param supervisor The supervisor
+ */
+-(void) reconnectSupervisorDidGiveUp:(VTReconnectSupervisor *)supervisor;
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+/** Reconnects a Node device after an unexpected disconnect and restores its streams.
+
+ The supervisor registers with VTNodeDeviceHub for connect and disconnect callbacks. After a drop
+ it calls connect with exponential backoff (initialDelay doubling up to maxDelay, each delay spread
+ by +/- jitter so several devices dropped together don't retry in lockstep), gives each attempt
+ attemptTimeout seconds before cancelling it, and gives up after maxAttempts. Once the device is
+ back and accepting commands, configuration is replayed with VTStreamConfiguration applyToDevice:.
+
+ Keep configuration in step with the streams the app enables; the library has no way to read them
+ back from the device. Calibrations, which disconnect the device on purpose, should be requested
+ through the supervisor; other such commands should be preceded by expectDisconnectWithResumeDelay:.
+ */
+@interface VTReconnectSupervisor : NSObject <NodeDeviceDelegate>
+
+/** The delegate object you want to receive recovery events */
+@property (weak, nonatomic) NSObject<VTReconnectSupervisorDelegate> *delegate;
+/** The device being supervised */
+@property (readonly, nonatomic) VTNodeDevice *device;
+/** The configuration replayed after reconnecting. May be modified in place. */
+@property (copy, nonatomic) VTStreamConfiguration *configuration;
+/** The current state */
+@property (readonly, nonatomic) VTReconnectState state;
+
+/** Delay before the first attempt in seconds (default 1) */
+@property (nonatomic) NSTimeInterval initialDelay;
+/** Upper bound on the delay between attempts in seconds (default 60) */
+@property (nonatomic) NSTimeInterval maxDelay;
+/** Fraction each delay is randomly varied by, 0-1 (default 0.2) */
+@property (nonatomic) double jitter;
+/** Seconds an attempt is given before it counts as failed (default 10) */
+@property (nonatomic) NSTimeInterval attemptTimeout;
+/** Attempts made before giving up; 0 means never give up (default 10) */
+@property (nonatomic) NSUInteger maxAttempts;
+
+/** Unexpected disconnects seen */
+@property (readonly, nonatomic) NSUInteger dropouts;
+/** Dropouts that were recovered */
+@property (readonly, nonatomic) NSUInteger recoveries;
+/** Dropouts that were given up on */
+@property (readonly, nonatomic) NSUInteger failures;
+/** Seconds the most recent recovery took */
+@property (readonly, nonatomic) NSTimeInterval lastRecoveryTime;
+/** Mean seconds per recovery */
+@property (readonly, nonatomic) NSTimeInterval meanRecoveryTime;
+/** Longest recovery in seconds */
+@property (readonly, nonatomic) NSTimeInterval maxRecoveryTime;
+
+/** Returns a supervisor for the given device
+
+ @param device The device to supervise
+ @return A VTReconnectSupervisor object
+ */
+-(id) initWithDevice:(VTNodeDevice *)device;
+
+/** Attaches the device to the shared hub and starts watching for disconnects. It can be called
+ from the device's own nodeDeviceDidConnect:. */
+-(void) start;
+
+/** Stops watching and cancels any pending attempt. Call this before disconnecting on purpose. */
+-(void) stop;
+
+/** Treats the next disconnect as intentional: it is not counted as a dropout, and the first
+ attempt is made after the given delay instead of initialDelay.
+
+ @param delay Seconds to wait after the disconnect before reconnecting (e.g. the time a calibration takes)
+ */
+-(void) expectDisconnectWithResumeDelay:(NSTimeInterval)delay;
+
+/** Puts the device into magnetometer calibration mode, which disconnects it, and reconnects it
+ afterwards without counting a dropout
+
+ @param delay Seconds to leave the device calibrating before reconnecting
+ */
+-(void) requestMagnetometerCalibrationResumingAfter:(NSTimeInterval)delay;
+
+/** Puts the device into gyroscope calibration mode, which disconnects it, and reconnects it
+ afterwards without counting a dropout
+
+ @param delay Seconds to leave the device calibrating before reconnecting
+ */
+-(void) requestGyroscopeCalibrationResumingAfter:(NSTimeInterval)delay;
+@end
@@ -0,0 +1,281 @@
+//
+//  VTReconnectSupervisor.m
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "VTReconnectSupervisor.h"
+#import "VTNodeDeviceHub.h"
+#include <stdlib.h>
+#include <math.h>
+
+@interface VTReconnectSupervisor ()
+{
+    NSTimer *timer;
+    NSUInteger attempt;
+    CFAbsoluteTime disconnectedAt;
+    NSTimeInterval totalRecoveryTime;
+    BOOL expectingDisconnect;
+    BOOL intentional;
+    NSTimeInterval resumeDelay;
+}
+@property (readwrite, nonatomic) VTReconnectState state;
+@end
+
+@implementation VTReconnectSupervisor
+
+@synthesize delegate;
+@synthesize device;
+@synthesize configuration;
+@synthesize state;
+@synthesize initialDelay;
+@synthesize maxDelay;
+@synthesize jitter;
+@synthesize attemptTimeout;
+@synthesize maxAttempts;
+@synthesize dropouts;
+@synthesize recoveries;
+@synthesize failures;
+@synthesize lastRecoveryTime;
+@synthesize maxRecoveryTime;
+
+-(id) initWithDevice:(VTNodeDevice *)aDevice
+{
+    self = [super init];
+    if (self) {
+        device = aDevice;
+        configuration = [[VTStreamConfiguration alloc] init];
+        initialDelay = 1.0;
+        maxDelay = 60.0;
+        jitter = 0.2;
+        attemptTimeout = 10.0;
+        maxAttempts = 10;
+    }
+    return self;
+}
+
+-(NSTimeInterval) meanRecoveryTime
+{
+    return recoveries ? totalRecoveryTime / recoveries : 0;
+}
+
+-(void) start
+{
+    VTNodeDeviceHub *hub = [VTNodeDeviceHub sharedInstance];
+    [hub attachDevice:device];
+    [hub addDelegate:self];
+    // Usually started from the connect callback itself, before the device is fully connected
+    self.state = (device.isFullyConnected || [[VTNodeController allConnectedNodeDevices] containsObject:device]) ? VTReconnectStateConnected : VTReconnectStateIdle;
+}
+
+-(void) stop
+{
+    [self cancelTimer];
+    [[VTNodeDeviceHub sharedInstance] removeDelegate:self];
+    expectingDisconnect = NO;
+    self.state = VTReconnectStateIdle;
+}
+
+-(void) expectDisconnectWithResumeDelay:(NSTimeInterval)delay
+{
+    expectingDisconnect = YES;
+    resumeDelay = MAX(delay, 0);
+}
+
+-(void) requestMagnetometerCalibrationResumingAfter:(NSTimeInterval)delay
+{
+    [self expectDisconnectWithResumeDelay:delay];
+    [device requestMagnetometerCalibration];
+}
+
+-(void) requestGyroscopeCalibrationResumingAfter:(NSTimeInterval)delay
+{
+    [self expectDisconnectWithResumeDelay:delay];
+    [device requestGyroscopeCalibration];
+}
+
+-(void) cancelTimer
+{
+    [timer invalidate];
+    timer = nil;
+}
+
+#pragma mark - Backoff
+-(NSTimeInterval) delayForAttempt:(NSUInteger)n
+{
+    if (n == 1 && intentional) {
+        return resumeDelay;
+    }
+
+    NSTimeInterval delay = initialDelay * pow(2.0, (double)(n - 1));
+    if (delay > maxDelay) {
+        delay = maxDelay;
+    }
+    double spread = ((double)arc4random_uniform(2001) / 1000.0 - 1.0) * jitter;
+    return MAX(0, delay * (1.0 + spread));
+}
+
+-(void) scheduleNextAttempt
+{
+    if (maxAttempts && attempt >= maxAttempts) {
+        [self giveUp];
+        return;
+    }
+
+    NSTimeInterval delay = [self delayForAttempt:attempt + 1];
+    if ([delegate respondsToSelector:@selector(reconnectSupervisor:willAttempt:afterDelay:)]) {
+        [delegate reconnectSupervisor:self willAttempt:attempt + 1 afterDelay:delay];
+    }
+
+    [self cancelTimer];
+    timer = [NSTimer scheduledTimerWithTimeInterval:delay target:self selector:@selector(attemptFired:) userInfo:nil repeats:NO];
+}
+
+-(void) attemptFired:(NSTimer *)aTimer
+{
+    attempt++;
+    NSLog(@"Reconnect attempt %lu for %@", (unsigned long)attempt, device.name);
+    // The hub detached the device when it disconnected
+    [[VTNodeDeviceHub sharedInstance] attachDevice:device];
+    [device connect];
+
+    timer = [NSTimer scheduledTimerWithTimeInterval:attemptTimeout target:self selector:@selector(attemptTimedOut:) userInfo:nil repeats:NO];
+}
+
+-(void) attemptTimedOut:(NSTimer *)aTimer
+{
+    timer = nil;
+    if (state == VTReconnectStateRestoring) {
+        // Connected but never reported ready; send the configuration anyway
+        [self restore];
+        return;
+    }
+    // Cancel the pending connect so it cannot complete behind a later attempt
+    [device disconnect];
+    [self scheduleNextAttempt];
+}
+
+-(void) giveUp
+{
+    [self cancelTimer];
+    [[VTNodeDeviceHub sharedInstance] removeDelegate:self];
+    if (!intentional) {
+        failures++;
+    }
+    self.state = VTReconnectStateIdle;
+    NSLog(@"Gave up reconnecting %@ after %lu attempts", device.name, (unsigned long)attempt);
+
+    if ([delegate respondsToSelector:@selector(reconnectSupervisorDidGiveUp:)]) {
+        [delegate reconnectSupervisorDidGiveUp:self];
+    }
+}
+
+#pragma mark - Restore
+-(void) restore
+{
+    [self cancelTimer];
+    [configuration applyToDevice:device];
+    self.state = VTReconnectStateConnected;
+
+    if (intentional) {
+        return;
+    }
+
+    NSTimeInterval elapsed = CFAbsoluteTimeGetCurrent() - disconnectedAt;
+    recoveries++;
+    totalRecoveryTime += elapsed;
+    lastRecoveryTime = elapsed;
+    maxRecoveryTime = MAX(maxRecoveryTime, elapsed);
+
+    if ([delegate respondsToSelector:@selector(reconnectSupervisor:didRecoverAfter:attempts:)]) {
+        [delegate reconnectSupervisor:self didRecoverAfter:elapsed attempts:attempt];
+    }
+}
+
+#pragma mark - Node Device Delegate
+-(void) nodeDeviceDidDisconnect:(VTNodeDevice *)aDevice
+{
+    if (aDevice != device) {
+        return;
+    }
+
+    switch (state) {
+        case VTReconnectStateConnected:
+            // A fresh dropout
+            intentional = expectingDisconnect;
+            expectingDisconnect = NO;
+            if (!intentional) {
+                dropouts++;
+            }
+            attempt = 0;
+            disconnectedAt = CFAbsoluteTimeGetCurrent();
+            self.state = VTReconnectStateReconnecting;
+            [self scheduleNextAttempt];
+            break;
+
+        case VTReconnectStateRestoring:
+            // Dropped again before the streams were restored; that attempt failed
+            self.state = VTReconnectStateReconnecting;
+            [self scheduleNextAttempt];
+            break;
+
+        default:
+            break;
+    }
+}
+
+-(void) nodeDeviceDidConnect:(VTNodeDevice *)aDevice
+{
+    if (aDevice != device) {
+        return;
+    }
+
+    if (state == VTReconnectStateIdle) {
+        self.state = VTReconnectStateConnected;
+        return;
+    }
+    if (state != VTReconnectStateReconnecting) {
+        return;
+    }
+
+    [self cancelTimer];
+    self.state = VTReconnectStateRestoring;
+    if (device.isFullyConnected) {
+        [self restore];
+    }
+    else {
+        timer = [NSTimer scheduledTimerWithTimeInterval:attemptTimeout target:self selector:@selector(attemptTimedOut:) userInfo:nil repeats:NO];
+    }
+}
+
+-(void) nodeDeviceDidUpdateDataMode:(VTNodeDevice *)aDevice withMode:(DeviceMode)mode
+{
+    if (aDevice != device) {
+        return;
+    }
+    if (state == VTReconnectStateIdle) {
+        // Started before the connect completed
+        self.state = VTReconnectStateConnected;
+    }
+    else if (state == VTReconnectStateRestoring && device.isFullyConnected) {
+        [self restore];
+    }
+}
+
+@end
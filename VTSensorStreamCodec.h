@@ -0,0 +1,117 @@
+//
+//  VTSensorStreamCodec.h
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "libNode.h"
+
+/** Encoding used for a chunk of three-axis readings */
+typedef enum {
+    /** Lossless XOR encoding of the raw IEEE 754 values (Gorilla style) */
+    VTSensorStreamModeFloatXor = 0,
+    /** Values quantized to a fixed resolution, delta encoded and bit-packed */
+    VTSensorStreamModeFixedPoint = 1
+} VTSensorStreamMode;
+
+////////////////////////////////////////////////////////////////////////////////
+/** Streams three-axis readings (VTSensorReading) into compact, self-contained chunks.
+
+ Readings are buffered into a preallocated chunk. When the chunk is full (or flush is called)
+ it is encoded and handed to the chunkHandler. Every chunk can be decoded on its own with
+ VTSensorStreamDecoder, so chunks can be stored or uploaded as they are produced.
+ */
+@interface VTSensorStreamEncoder : NSObject
+
+/** The number of readings per chunk */
+@property (readonly, nonatomic) NSUInteger chunkCapacity;
+/** The resolution used by VTSensorStreamModeFixedPoint, or 0 for lossless float encoding */
+@property (readonly, nonatomic) float resolution;
+/** Invoked with each encoded chunk */
+@property (copy, nonatomic) void (^chunkHandler)(NSData *chunk);
+
+/** Total size of the readings encoded so far, as raw floats */
+@property (readonly, nonatomic) unsigned long long rawBytes;
+/** Total size of the chunks produced so far */
+@property (readonly, nonatomic) unsigned long long encodedBytes;
+/** rawBytes / encodedBytes (0 until the first chunk has been produced) */
+@property (readonly, nonatomic) double compressionRatio;
+/** Raw megabytes encoded per second of encoding time */
+@property (readonly, nonatomic) double throughputMBps;
+
+/** Returns an encoder that encodes readings losslessly.
+
+ @param capacity The number of readings per chunk (1-65535)
+ @return A VTSensorStreamEncoder using VTSensorStreamModeFloatXor
+ */
+-(id) initWithChunkCapacity:(NSUInteger)capacity;
+
+/** Returns an encoder that quantizes readings to the sensor's resolution.
+
+ Values are rounded to the nearest multiple of resolution, so decoding is exact up to that
+ resolution. Chunks that cannot be represented (NaN, infinite or out-of-range values) fall back
+ to lossless float encoding automatically.
+
+ @param capacity The number of readings per chunk (1-65535)
+ @param resolution The smallest step reported by the sensor, or 0 for lossless float encoding
+ @return A VTSensorStreamEncoder
+ */
+-(id) initWithChunkCapacity:(NSUInteger)capacity resolution:(float)resolution;
+
+/** Buffers a reading, encoding the chunk when it becomes full
+
+ @param reading The reading to append
+ */
+-(void) appendReading:(VTSensorReading *)reading;
+
+/** Buffers a reading given by its three axis values
+
+ @param x The x axis value
+ @param y The y axis value
+ @param z The z axis value
+ */
+-(void) appendX:(float)x y:(float)y z:(float)z;
+
+/** Encodes any buffered readings as a (possibly short) chunk */
+-(void) flush;
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+/** Decodes chunks produced by VTSensorStreamEncoder */
+@interface VTSensorStreamDecoder : NSObject
+
+/** Decodes a single chunk.
+
+ @param chunk A chunk produced by VTSensorStreamEncoder
+ @return An array of VTSensorReading objects, or nil if the chunk is malformed
+ */
++(NSArray *) readingsFromChunk:(NSData *)chunk;
+
+/** Decodes a single chunk into caller-provided buffers.
+
+ @param chunk A chunk produced by VTSensorStreamEncoder
+ @param x Receives the x axis values (at least chunkCapacity entries)
+ @param y Receives the y axis values (at least chunkCapacity entries)
+ @param z Receives the z axis values (at least chunkCapacity entries)
+ @param capacity The number of entries available in each buffer
+ @return The number of readings decoded, or -1 if the chunk is malformed or too large
+ */
++(NSInteger) decodeChunk:(NSData *)chunk x:(float *)x y:(float *)y z:(float *)z capacity:(NSUInteger)capacity;
+@end
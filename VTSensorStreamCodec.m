@@ -0,0 +1,429 @@
+//
+//  VTSensorStreamCodec.m
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "VTSensorStreamCodec.h"
+#import <Accelerate/Accelerate.h>
+#include <math.h>
+
+#define VT_CODEC_VERSION        1
+#define VT_CODEC_HEADER_SIZE    4
+#define VT_CODEC_MAX_CAPACITY   65535
+// Quantized values are kept within +/-2^30 so deltas always fit in 32 bits after zigzag encoding
+#define VT_CODEC_FIXED_LIMIT    1073741824.0f
+
+// ====================================================
+// Bit-level helpers (MSB first)
+// ====================================================
+
+typedef struct {
+    uint8_t *buf;
+    size_t pos;
+} VTBitWriter;
+
+typedef struct {
+    const uint8_t *buf;
+    size_t pos;
+    size_t limit;
+} VTBitReader;
+
+static void VTBitWrite(VTBitWriter *w, uint32_t value, unsigned bits)
+{
+    while (bits > 0) {
+        unsigned room = 8 - (w->pos & 7);
+        unsigned take = bits < room ? bits : room;
+        uint8_t part = (value >> (bits - take)) & ((1u << take) - 1);
+        w->buf[w->pos >> 3] |= part << (room - take);
+        w->pos += take;
+        bits -= take;
+    }
+}
+
+static BOOL VTBitRead(VTBitReader *r, unsigned bits, uint32_t *out)
+{
+    if (r->pos + bits > r->limit) {
+        return NO;
+    }
+    uint32_t value = 0;
+    while (bits > 0) {
+        unsigned room = 8 - (r->pos & 7);
+        unsigned take = bits < room ? bits : room;
+        uint8_t byte = r->buf[r->pos >> 3];
+        value = (value << take) | ((byte >> (room - take)) & ((1u << take) - 1));
+        r->pos += take;
+        bits -= take;
+    }
+    *out = value;
+    return YES;
+}
+
+static unsigned VTLeadingZeros(uint32_t v)
+{
+    unsigned n = 0;
+    while (n < 32 && !(v & 0x80000000u)) { v <<= 1; n++; }
+    return n;
+}
+
+static unsigned VTTrailingZeros(uint32_t v)
+{
+    unsigned n = 0;
+    while (n < 32 && !(v & 1u)) { v >>= 1; n++; }
+    return n;
+}
+
+static inline uint32_t VTFloatBits(float f) { uint32_t u; memcpy(&u, &f, 4); return u; }
+static inline float VTBitsFloat(uint32_t u) { float f; memcpy(&f, &u, 4); return f; }
+static inline uint32_t VTZigZag(int64_t v) { return (uint32_t)((v << 1) ^ (v >> 63)); }
+static inline int64_t VTUnZigZag(uint32_t v) { return (int64_t)(v >> 1) ^ -(int64_t)(v & 1); }
+
+// ====================================================
+// Per-axis encoders
+// ====================================================
+
+static void VTEncodeXorAxis(VTBitWriter *w, const float *values, NSUInteger count)
+{
+    uint32_t prev = VTFloatBits(values[0]);
+    VTBitWrite(w, prev, 32);
+
+    unsigned prevLead = 33, prevTrail = 0;
+    for (NSUInteger i = 1; i < count; i++) {
+        uint32_t cur = VTFloatBits(values[i]);
+        uint32_t x = cur ^ prev;
+        prev = cur;
+
+        if (x == 0) {
+            VTBitWrite(w, 0, 1);
+            continue;
+        }
+        VTBitWrite(w, 1, 1);
+
+        unsigned lead = VTLeadingZeros(x);
+        unsigned trail = VTTrailingZeros(x);
+        if (prevLead <= 32 && lead >= prevLead && trail >= prevTrail) {
+            // Meaningful bits fit inside the previous window
+            VTBitWrite(w, 0, 1);
+            VTBitWrite(w, x >> prevTrail, 32 - prevLead - prevTrail);
+        }
+        else {
+            unsigned significant = 32 - lead - trail;
+            VTBitWrite(w, 1, 1);
+            VTBitWrite(w, lead, 5);
+            VTBitWrite(w, significant - 1, 5);
+            VTBitWrite(w, x >> trail, significant);
+            prevLead = lead;
+            prevTrail = trail;
+        }
+    }
+}
+
+static BOOL VTDecodeXorAxis(VTBitReader *r, float *values, NSUInteger count)
+{
+    uint32_t prev;
+    if (!VTBitRead(r, 32, &prev)) return NO;
+    values[0] = VTBitsFloat(prev);
+
+    unsigned prevLead = 33, prevTrail = 0;
+    for (NSUInteger i = 1; i < count; i++) {
+        uint32_t flag, x;
+        if (!VTBitRead(r, 1, &flag)) return NO;
+        if (flag == 0) {
+            values[i] = VTBitsFloat(prev);
+            continue;
+        }
+        if (!VTBitRead(r, 1, &flag)) return NO;
+        if (flag == 0) {
+            if (prevLead > 32) return NO;
+            if (!VTBitRead(r, 32 - prevLead - prevTrail, &x)) return NO;
+            x <<= prevTrail;
+        }
+        else {
+            uint32_t lead, significant;
+            if (!VTBitRead(r, 5, &lead) || !VTBitRead(r, 5, &significant)) return NO;
+            significant += 1;
+            if (lead + significant > 32) return NO;
+            if (!VTBitRead(r, significant, &x)) return NO;
+            prevLead = lead;
+            prevTrail = 32 - lead - significant;
+            x = (prevTrail == 32) ? 0 : x << prevTrail;
+        }
+        prev ^= x;
+        values[i] = VTBitsFloat(prev);
+    }
+    return YES;
+}
+
+static void VTEncodeFixedAxis(VTBitWriter *w, const int32_t *q, NSUInteger count)
+{
+    // Frame-of-reference packing: every delta in the chunk uses the width of the largest one
+    unsigned width = 0;
+    for (NSUInteger i = 1; i < count; i++) {
+        uint32_t zz = VTZigZag((int64_t)q[i] - q[i - 1]);
+        unsigned bits = 32 - VTLeadingZeros(zz);
+        if (bits > width) width = bits;
+    }
+
+    VTBitWrite(w, (uint32_t)q[0], 32);
+    VTBitWrite(w, width, 6);
+    if (width == 0) {
+        return;
+    }
+    for (NSUInteger i = 1; i < count; i++) {
+        VTBitWrite(w, VTZigZag((int64_t)q[i] - q[i - 1]), width);
+    }
+}
+
+static BOOL VTDecodeFixedAxis(VTBitReader *r, float *values, NSUInteger count, float resolution)
+{
+    uint32_t first, width, zz;
+    if (!VTBitRead(r, 32, &first) || !VTBitRead(r, 6, &width) || width > 32) return NO;
+
+    int64_t q = (int32_t)first;
+    values[0] = q * resolution;
+    for (NSUInteger i = 1; i < count; i++) {
+        zz = 0;
+        if (width > 0 && !VTBitRead(r, width, &zz)) return NO;
+        q += VTUnZigZag(zz);
+        values[i] = q * resolution;
+    }
+    return YES;
+}
+
+// Worst case for one float XOR value is 1 + 1 + 5 + 5 + 32 bits
+static size_t VTWorstCaseChunkSize(NSUInteger count)
+{
+    return VT_CODEC_HEADER_SIZE + 4 + (3 * (32 + 6 + 44 * count) + 7) / 8;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+@interface VTSensorStreamEncoder ()
+{
+    float *axis[3];
+    int32_t *quantized;
+    uint8_t *scratch;
+    size_t scratchSize;
+    NSUInteger count;
+    CFAbsoluteTime encodeTime;
+}
+@end
+
+@implementation VTSensorStreamEncoder
+
+@synthesize chunkCapacity;
+@synthesize resolution;
+@synthesize chunkHandler;
+@synthesize rawBytes;
+@synthesize encodedBytes;
+
+-(id) initWithChunkCapacity:(NSUInteger)capacity
+{
+    return [self initWithChunkCapacity:capacity resolution:0];
+}
+
+-(id) initWithChunkCapacity:(NSUInteger)capacity resolution:(float)res
+{
+    self = [super init];
+    if (self) {
+        if (capacity < 1) capacity = 1;
+        if (capacity > VT_CODEC_MAX_CAPACITY) capacity = VT_CODEC_MAX_CAPACITY;
+        chunkCapacity = capacity;
+        resolution = (res > 0 && isfinite(res)) ? res : 0;
+
+        // All buffers are allocated once; encoding a chunk does not allocate until the result is handed out
+        for (int a = 0; a < 3; a++) {
+            axis[a] = malloc(capacity * sizeof(float));
+        }
+        quantized = malloc(capacity * sizeof(int32_t));
+        scratchSize = VTWorstCaseChunkSize(capacity);
+        scratch = malloc(scratchSize);
+    }
+    return self;
+}
+
+-(void) dealloc
+{
+    for (int a = 0; a < 3; a++) {
+        free(axis[a]);
+    }
+    free(quantized);
+    free(scratch);
+}
+
+-(double) compressionRatio
+{
+    return encodedBytes ? (double)rawBytes / (double)encodedBytes : 0;
+}
+
+-(double) throughputMBps
+{
+    return encodeTime > 0 ? (rawBytes / (1024.0 * 1024.0)) / encodeTime : 0;
+}
+
+-(void) appendReading:(VTSensorReading *)reading
+{
+    [self appendX:reading.x y:reading.y z:reading.z];
+}
+
+-(void) appendX:(float)x y:(float)y z:(float)z
+{
+    axis[0][count] = x;
+    axis[1][count] = y;
+    axis[2][count] = z;
+    count++;
+
+    if (count == chunkCapacity) {
+        [self flush];
+    }
+}
+
+-(void) flush
+{
+    if (count == 0) {
+        return;
+    }
+
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    size_t used = [self encodeChunk];
+    encodeTime += CFAbsoluteTimeGetCurrent() - start;
+
+    rawBytes += count * 3 * sizeof(float);
+    encodedBytes += used;
+    count = 0;
+
+    if (self.chunkHandler) {
+        self.chunkHandler([NSData dataWithBytes:scratch length:used]);
+    }
+}
+
+// Returns YES if every buffered value can be quantized at the configured resolution
+-(BOOL) canQuantize
+{
+    if (resolution <= 0) {
+        return NO;
+    }
+    vDSP_Length n = count;
+    for (int a = 0; a < 3; a++) {
+        float sum, maxMag;
+        // NaN or infinity anywhere in the axis makes the sum non-finite
+        vDSP_sve(axis[a], 1, &sum, n);
+        vDSP_maxmgv(axis[a], 1, &maxMag, n);
+        if (!isfinite(sum) || !(maxMag / resolution < VT_CODEC_FIXED_LIMIT)) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+-(size_t) encodeChunk
+{
+    BOOL fixed = [self canQuantize];
+    memset(scratch, 0, scratchSize);
+
+    scratch[0] = VT_CODEC_VERSION;
+    scratch[1] = fixed ? VTSensorStreamModeFixedPoint : VTSensorStreamModeFloatXor;
+    scratch[2] = count & 0xff;
+    scratch[3] = (count >> 8) & 0xff;
+
+    VTBitWriter w = { scratch, VT_CODEC_HEADER_SIZE * 8 };
+    if (fixed) {
+        VTBitWrite(&w, VTFloatBits(resolution), 32);
+        for (int a = 0; a < 3; a++) {
+            float inverse = 1.0f / resolution;
+            vDSP_vsmul(axis[a], 1, &inverse, axis[a], 1, count);
+            vDSP_vfixr32(axis[a], 1, quantized, 1, count);
+            VTEncodeFixedAxis(&w, quantized, count);
+        }
+    }
+    else {
+        for (int a = 0; a < 3; a++) {
+            VTEncodeXorAxis(&w, axis[a], count);
+        }
+    }
+    return (w.pos + 7) / 8;
+}
+
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+@implementation VTSensorStreamDecoder
+
++(NSInteger) decodeChunk:(NSData *)chunk x:(float *)x y:(float *)y z:(float *)z capacity:(NSUInteger)capacity
+{
+    const uint8_t *bytes = [chunk bytes];
+    NSUInteger length = [chunk length];
+    if (length < VT_CODEC_HEADER_SIZE || bytes[0] != VT_CODEC_VERSION) {
+        return -1;
+    }
+
+    uint8_t mode = bytes[1];
+    NSUInteger n = bytes[2] | (bytes[3] << 8);
+    if (n == 0 || n > capacity) {
+        return -1;
+    }
+
+    VTBitReader r = { bytes, VT_CODEC_HEADER_SIZE * 8, length * 8 };
+    float *out[3] = { x, y, z };
+
+    if (mode == VTSensorStreamModeFixedPoint) {
+        uint32_t resBits;
+        if (!VTBitRead(&r, 32, &resBits)) return -1;
+        float res = VTBitsFloat(resBits);
+        if (!(res > 0)) return -1;
+        for (int a = 0; a < 3; a++) {
+            if (!VTDecodeFixedAxis(&r, out[a], n, res)) return -1;
+        }
+    }
+    else if (mode == VTSensorStreamModeFloatXor) {
+        for (int a = 0; a < 3; a++) {
+            if (!VTDecodeXorAxis(&r, out[a], n)) return -1;
+        }
+    }
+    else {
+        return -1;
+    }
+    return n;
+}
+
++(NSArray *) readingsFromChunk:(NSData *)chunk
+{
+    NSUInteger capacity = VT_CODEC_MAX_CAPACITY;
+    if ([chunk length] >= VT_CODEC_HEADER_SIZE) {
+        const uint8_t *bytes = [chunk bytes];
+        capacity = bytes[2] | (bytes[3] << 8);
+    }
+
+    NSMutableData *buffer = [NSMutableData dataWithLength:capacity * 3 * sizeof(float)];
+    float *x = [buffer mutableBytes];
+    float *y = x + capacity;
+    float *z = y + capacity;
+
+    NSInteger n = [self decodeChunk:chunk x:x y:y z:z capacity:capacity];
+    if (n < 0) {
+        return nil;
+    }
+
+    NSMutableArray *readings = [[NSMutableArray alloc] initWithCapacity:n];
+    for (NSInteger i = 0; i < n; i++) {
+        [readings addObject:[[VTSensorReading alloc] initWithXValue:x[i] y:y[i] z:z[i]]];
+    }
+    return readings;
+}
+
+@end
@@ -0,0 +1,90 @@
+//
+//  VTStreamConfiguration.h
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "libNode.h"
+
+/** The streaming, LED and Luma state that has been requested from a Node device.
+
+ VTNodeDevice does not report which streams are active, so anything that needs to reason about
+ (or restore) a device's state keeps one of these alongside it. Periods use the same 10ms units as
+ the VTNodeDevice streaming methods.
+ */
+@interface VTStreamConfiguration : NSObject <NSCopying>
+
+// KORE
+@property (nonatomic) bool koreAcc;
+@property (nonatomic) bool koreGyro;
+@property (nonatomic) bool koreMag;
+/** Period between KORE readings in units of 10ms (default 2) */
+@property (nonatomic) uint16_t korePeriod;
+
+// Orientation
+@property (nonatomic) bool oriYpr;
+@property (nonatomic) bool oriQuat;
+
+// CLIMA
+@property (nonatomic) bool climaTempPressure;
+@property (nonatomic) bool climaHumidity;
+@property (nonatomic) bool climaLightProximity;
+/** Period between Clima readings in units of 10ms (default 25) */
+@property (nonatomic) uint16_t climaPeriod;
+
+// THERMA
+@property (nonatomic) bool irThermo;
+@property (nonatomic) bool irThermoLed;
+/** Period between IR Therma readings in units of 10ms (default 10) */
+@property (nonatomic) uint16_t irThermoPeriod;
+
+// OXA
+@property (nonatomic) bool oxa;
+/** Period between OXA readings in units of 10ms (default 100) */
+@property (nonatomic) uint16_t oxaPeriod;
+
+// LUMA
+/** LUMA LED mask, as passed to setLumaMode: */
+@property (nonatomic) uint8_t lumaMode;
+
+// LEDs
+@property (nonatomic) uint8_t ledABlue;
+@property (nonatomic) uint8_t ledBBlue;
+@property (nonatomic) uint8_t ledARed;
+@property (nonatomic) uint8_t ledBRed;
+
+/** True if any stream is enabled */
+@property (readonly, nonatomic) bool isStreaming;
+
+/** Sends every stream, LED and Luma setting in this configuration to a device.
+
+ Disabled streams are explicitly turned off, so the device ends up in exactly this state.
+
+ @param device The device to configure
+ */
+-(void) applyToDevice:(VTNodeDevice *)device;
+
+/** Sends only the commands whose settings differ from the configuration a device already has.
+
+ @param device The device to configure
+ @param previous The configuration last applied to the device, or nil to send everything
+ */
+-(void) applyToDevice:(VTNodeDevice *)device previous:(VTStreamConfiguration *)previous;
+@end
@@ -0,0 +1,121 @@
+//
+//  VTStreamConfiguration.m
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "VTStreamConfiguration.h"
+
+@implementation VTStreamConfiguration
+
+@synthesize koreAcc, koreGyro, koreMag, korePeriod;
+@synthesize oriYpr, oriQuat;
+@synthesize climaTempPressure, climaHumidity, climaLightProximity, climaPeriod;
+@synthesize irThermo, irThermoLed, irThermoPeriod;
+@synthesize oxa, oxaPeriod;
+@synthesize lumaMode;
+@synthesize ledABlue, ledBBlue, ledARed, ledBRed;
+
+- (id)init
+{
+    self = [super init];
+    if (self) {
+        // Defaults match the VTNodeDevice convenience methods
+        korePeriod = 2;
+        climaPeriod = 25;
+        irThermoPeriod = 10;
+        oxaPeriod = 100;
+    }
+    return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    VTStreamConfiguration *copy = [[[self class] allocWithZone:zone] init];
+    copy.koreAcc = koreAcc;
+    copy.koreGyro = koreGyro;
+    copy.koreMag = koreMag;
+    copy.korePeriod = korePeriod;
+    copy.oriYpr = oriYpr;
+    copy.oriQuat = oriQuat;
+    copy.climaTempPressure = climaTempPressure;
+    copy.climaHumidity = climaHumidity;
+    copy.climaLightProximity = climaLightProximity;
+    copy.climaPeriod = climaPeriod;
+    copy.irThermo = irThermo;
+    copy.irThermoLed = irThermoLed;
+    copy.irThermoPeriod = irThermoPeriod;
+    copy.oxa = oxa;
+    copy.oxaPeriod = oxaPeriod;
+    copy.lumaMode = lumaMode;
+    copy.ledABlue = ledABlue;
+    copy.ledBBlue = ledBBlue;
+    copy.ledARed = ledARed;
+    copy.ledBRed = ledBRed;
+    return copy;
+}
+
+- (bool)isStreaming
+{
+    return koreAcc || koreGyro || koreMag || oriYpr || oriQuat ||
+           climaTempPressure || climaHumidity || climaLightProximity || irThermo || oxa;
+}
+
+- (void)applyToDevice:(VTNodeDevice *)device
+{
+    [self applyToDevice:device previous:nil];
+}
+
+- (void)applyToDevice:(VTNodeDevice *)device previous:(VTStreamConfiguration *)p
+{
+    if (!p || p.koreAcc != koreAcc || p.koreGyro != koreGyro || p.koreMag != koreMag || p.korePeriod != korePeriod) {
+        [device setStreamModeAcc:koreAcc Gyro:koreGyro Mag:koreMag withPeriod:korePeriod withLifetime:0];
+    }
+    if (!p || p.oriYpr != oriYpr || p.oriQuat != oriQuat) {
+        [device setStreamModeOriYpr:oriYpr QuatMode:oriQuat];
+    }
+    if (!p || p.climaTempPressure != climaTempPressure || p.climaHumidity != climaHumidity ||
+        p.climaLightProximity != climaLightProximity || p.climaPeriod != climaPeriod) {
+        [device setStreamModeClimaTP:climaTempPressure Humidity:climaHumidity LightProximity:climaLightProximity withPeriod:climaPeriod withLifetime:0];
+    }
+    if (!p || p.irThermo != irThermo || p.irThermoLed != irThermoLed || p.irThermoPeriod != irThermoPeriod) {
+        [device setStreamModeIRThermo:irThermo withLedPower:irThermoLed withPeriod:irThermoPeriod withLifetime:0];
+    }
+    if (!p || p.oxa != oxa || p.oxaPeriod != oxaPeriod) {
+        [device setStreamModeOxa:oxa withPeriod:oxaPeriod withLifetime:0];
+    }
+    if (!p || p.lumaMode != lumaMode) {
+        [device setLumaMode:lumaMode];
+    }
+    if (!p || p.ledABlue != ledABlue || p.ledBBlue != ledBBlue || p.ledARed != ledARed || p.ledBRed != ledBRed) {
+        [device setLedABlue:ledABlue BBlue:ledBBlue ARed:ledARed BRed:ledBRed];
+    }
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@ kore:%d%d%d/%u ori:%d%d clima:%d%d%d/%u therma:%d(led %d)/%u oxa:%d/%u luma:0x%02x leds:%u,%u,%u,%u>",
+            NSStringFromClass([self class]),
+            koreAcc, koreGyro, koreMag, korePeriod, oriYpr, oriQuat,
+            climaTempPressure, climaHumidity, climaLightProximity, climaPeriod,
+            irThermo, irThermoLed, irThermoPeriod, oxa, oxaPeriod, lumaMode,
+            ledABlue, ledBBlue, ledARed, ledBRed];
+}
+
+@end
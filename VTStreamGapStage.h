@@ -0,0 +1,111 @@
+//
+//  VTStreamGapStage.h
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "VTNodeDeviceHub.h"
+
+////////////////////////////////////////////////////////////////////////////////
+/** Loss statistics for one channel (of one device, or summed over all devices) */
+@interface VTStreamLossStats : NSObject
+/** Samples that arrived */
+@property (nonatomic) unsigned long long received;
+/** Samples estimated to be missing from the gaps detected */
+@property (nonatomic) unsigned long long missing;
+/** Samples synthesized to fill gaps */
+@property (nonatomic) unsigned long long interpolated;
+/** Samples that arrived out of order and were put back in place */
+@property (nonatomic) unsigned long long reordered;
+/** Samples that arrived too late to be put back in place and were discarded */
+@property (nonatomic) unsigned long long droppedLate;
+/** Number of gaps detected */
+@property (nonatomic) unsigned long long gaps;
+/** missing / (received + missing) */
+@property (readonly, nonatomic) double lossRatio;
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+/** A hub stage that detects, reorders and optionally fills gaps in lossy streams.
+
+ The Node protocol carries no sequence numbers, so gaps are found from timing: each device and
+ channel has an expected period (set with setExpectedPeriod:forChannel:, or learned from the mean
+ interval over at least 32 samples and 2 seconds), and the stage tracks how far the stream has
+ fallen behind that schedule. BLE delivers notifications in bursts at each connection event, so
+ samples running up to half of deliveryJitter (or gapThreshold - 1 periods, if longer) behind are
+ not lost; beyond that the stream is taken to be missing samples. A learned period follows a stream
+ that speeds up by a quarter or more, and one that slows down: after four consecutive gaps of about
+ the same length, that length becomes the period and those gaps are no longer counted as loss.
+
+ A learned period cannot tell a stream that was already losing samples while it was learned from a
+ slower one, so such loss is under-counted; set the expected period when it is known.
+
+ Samples are held for up to reorderWindow seconds so late arrivals can be put back in timestamp
+ order; a held sample is also released once it has waited reorderWindow seconds, even if nothing
+ else arrives on its channel. Samples that arrive after newer ones have already been passed on are
+ dropped.
+ Gaps of up to maxFillSamples samples are filled by linear interpolation; the synthesized samples
+ carry VTSampleFlagInterpolated.
+
+ Readings from devices are timestamped on arrival, so out-of-order samples only occur for samples
+ injected with their own timestamps (VTNodeDeviceHub injectSample:).
+ */
+@interface VTStreamGapStage : NSObject <VTSampleStage>
+
+/** The channels processed (default: every channel except battery). Set before adding the stage to the hub. */
+@property (nonatomic) uint32_t channels;
+/** A steady stream whose interval exceeds this many expected periods has a gap (default 1.5) */
+@property (nonatomic) double gapThreshold;
+/** Spread, in seconds, of the delays with which samples arrive (default 0.05, above the longest
+ usual BLE connection interval) */
+@property (nonatomic) NSTimeInterval deliveryJitter;
+/** Seconds samples are held back for reordering (default 0, no reordering) */
+@property (nonatomic) NSTimeInterval reorderWindow;
+/** Largest gap, in samples, that is filled by interpolation (default 0, no filling) */
+@property (nonatomic) NSUInteger maxFillSamples;
+/** Seconds without samples after which a device's state for a channel is discarded, or 0 to keep it
+ (default 60). Its statistics remain in statisticsForChannel:. */
+@property (nonatomic) NSTimeInterval trackTimeout;
+
+/** Sets the expected period of a channel instead of learning it
+
+ @param period The period in seconds, or 0 to learn it from the stream
+ @param channel The channel
+ */
+-(void) setExpectedPeriod:(NSTimeInterval)period forChannel:(VTSampleChannel)channel;
+
+/** Returns loss statistics for a channel summed over all devices
+
+ @param channel The channel
+ @return A snapshot of the statistics
+ */
+-(VTStreamLossStats *) statisticsForChannel:(VTSampleChannel)channel;
+
+/** Returns loss statistics for a channel of one device
+
+ @param deviceID The device identifier (see VTNodeSample deviceID)
+ @param channel The channel
+ @return A snapshot of the statistics, or nil if the device has not been seen on that channel
+ */
+-(VTStreamLossStats *) statisticsForDeviceID:(NSString *)deviceID channel:(VTSampleChannel)channel;
+
+/** Forgets all learned periods, held samples and statistics */
+-(void) reset;
+@end
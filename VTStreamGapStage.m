@@ -0,0 +1,407 @@
+//
+//  VTStreamGapStage.m
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "VTStreamGapStage.h"
+#include <math.h>
+
+// Consecutive gaps of a consistent length after which a learned period is taken to have slowed down
+#define VT_GAP_RELEARN_RUN          4
+// A period is learned from the mean interval over at least this many intervals and seconds, so
+// bursts of notifications delivered in one connection event average out
+#define VT_GAP_LEARN_INTERVALS      32
+#define VT_GAP_LEARN_SECONDS        2.0
+
+@implementation VTStreamLossStats
+
+@synthesize received, missing, interpolated, reordered, droppedLate, gaps;
+
+-(double) lossRatio
+{
+    unsigned long long expected = received + missing;
+    return expected ? (double)missing / (double)expected : 0;
+}
+
+-(void) addStats:(VTStreamLossStats *)other
+{
+    received += other.received;
+    missing += other.missing;
+    interpolated += other.interpolated;
+    reordered += other.reordered;
+    droppedLate += other.droppedLate;
+    gaps += other.gaps;
+}
+
+-(NSString *) description
+{
+    return [NSString stringWithFormat:@"<%@ received:%llu missing:%llu (%.2f%%) gaps:%llu filled:%llu reordered:%llu late:%llu>",
+            NSStringFromClass([self class]), received, missing, self.lossRatio * 100.0, gaps, interpolated, reordered, droppedLate];
+}
+
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+// State for one channel of one device
+@interface VTGapTrack : NSObject
+{
+@public
+    NSMutableArray *held;
+    CFAbsoluteTime *heldSince;
+    NSUInteger heldCapacity;
+    VTNodeSample *lastEmitted;
+    // Wall-clock time the device last sent a sample on this channel
+    CFAbsoluteTime lastArrival;
+    NSTimeInterval learnedPeriod;
+    // The window the period is being learned (or checked for a speed-up) over, in periods counted
+    NSTimeInterval learnSum;
+    NSUInteger learnCount;
+    // How far behind the expected schedule the stream is, in seconds
+    NSTimeInterval lateness;
+    // The current run of gaps of about the same length, and what they were counted as
+    NSTimeInterval slowInterval;
+    NSUInteger slowRun;
+    unsigned long long slowMissing;
+    VTStreamLossStats *stats;
+}
+@end
+
+@implementation VTGapTrack
+
+-(id) init
+{
+    self = [super init];
+    if (self) {
+        held = [[NSMutableArray alloc] init];
+        stats = [[VTStreamLossStats alloc] init];
+    }
+    return self;
+}
+
+-(void) dealloc
+{
+    free(heldSince);
+}
+
+// Keeps heldSince (wall-clock hold start) parallel to held
+-(void) insertHeld:(VTNodeSample *)sample atIndex:(NSUInteger)index
+{
+    NSUInteger count = [held count];
+    if (count + 1 > heldCapacity) {
+        heldCapacity = MAX(16, heldCapacity * 2);
+        heldSince = realloc(heldSince, heldCapacity * sizeof(CFAbsoluteTime));
+    }
+    memmove(heldSince + index + 1, heldSince + index, (count - index) * sizeof(CFAbsoluteTime));
+    heldSince[index] = CFAbsoluteTimeGetCurrent();
+    [held insertObject:sample atIndex:index];
+}
+
+-(VTNodeSample *) popHeld
+{
+    VTNodeSample *sample = [held objectAtIndex:0];
+    [held removeObjectAtIndex:0];
+    memmove(heldSince, heldSince + 1, [held count] * sizeof(CFAbsoluteTime));
+    return sample;
+}
+
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+@interface VTStreamGapStage ()
+{
+    NSTimeInterval expectedPeriod[VTSampleChannelCount];
+    // deviceID -> VTGapTrack, one dictionary per channel
+    NSMutableDictionary *tracks[VTSampleChannelCount];
+    // Statistics of tracks expired per channel, so totals survive devices going away
+    VTStreamLossStats *expiredStats[VTSampleChannelCount];
+}
+@end
+
+@implementation VTStreamGapStage
+
+@synthesize channels;
+@synthesize gapThreshold;
+@synthesize reorderWindow;
+@synthesize maxFillSamples;
+@synthesize deliveryJitter;
+@synthesize trackTimeout;
+
+-(id) init
+{
+    self = [super init];
+    if (self) {
+        channels = VTSampleChannelMaskAll & ~VTSampleChannelMask(VTSampleChannelBattery);
+        gapThreshold = 1.5;
+        deliveryJitter = 0.05;
+        trackTimeout = 60.0;
+        [self reset];
+    }
+    return self;
+}
+
+-(void) reset
+{
+    for (int ch = 0; ch < VTSampleChannelCount; ch++) {
+        tracks[ch] = [[NSMutableDictionary alloc] init];
+        expiredStats[ch] = [[VTStreamLossStats alloc] init];
+    }
+}
+
+-(void) setExpectedPeriod:(NSTimeInterval)period forChannel:(VTSampleChannel)channel
+{
+    expectedPeriod[channel] = period > 0 ? period : 0;
+}
+
+#pragma mark - Statistics
+-(VTStreamLossStats *) statisticsForChannel:(VTSampleChannel)channel
+{
+    VTStreamLossStats *total = [[VTStreamLossStats alloc] init];
+    [total addStats:expiredStats[channel]];
+    for (VTGapTrack *track in [tracks[channel] objectEnumerator]) {
+        [total addStats:track->stats];
+    }
+    return total;
+}
+
+-(VTStreamLossStats *) statisticsForDeviceID:(NSString *)deviceID channel:(VTSampleChannel)channel
+{
+    VTGapTrack *track = [tracks[channel] objectForKey:deviceID];
+    if (track == nil) {
+        return nil;
+    }
+    VTStreamLossStats *copy = [[VTStreamLossStats alloc] init];
+    [copy addStats:track->stats];
+    return copy;
+}
+
+#pragma mark - VTSampleStage
+-(uint32_t) stageChannels
+{
+    return channels;
+}
+
+-(NSArray *) stageProcessSamples:(NSArray *)samples channel:(VTSampleChannel)channel
+{
+    NSMutableArray *output = [[NSMutableArray alloc] initWithCapacity:[samples count]];
+    NSMutableDictionary *channelTracks = tracks[channel];
+    CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+
+    for (VTNodeSample *sample in samples) {
+        VTGapTrack *track = [channelTracks objectForKey:sample.deviceID];
+        if (track == nil) {
+            track = [[VTGapTrack alloc] init];
+            [channelTracks setObject:track forKey:sample.deviceID];
+        }
+        track->stats.received++;
+        track->lastArrival = now;
+
+        if (track->lastEmitted && sample.timestamp <= track->lastEmitted.timestamp) {
+            track->stats.droppedLate++;
+            continue;
+        }
+
+        // Insert in timestamp order, searching from the end since most samples arrive in order
+        NSUInteger index = [track->held count];
+        while (index > 0 && ((VTNodeSample *)[track->held objectAtIndex:index - 1]).timestamp > sample.timestamp) {
+            index--;
+        }
+        if (index < [track->held count]) {
+            track->stats.reordered++;
+        }
+        [track insertHeld:sample atIndex:index];
+    }
+
+    // Release whatever has been held long enough, by stream time or by wall-clock time. The hub
+    // flushes again when the oldest held sample is due, so this also runs after a stream stops.
+    NSMutableArray *expired = nil;
+    for (NSString *deviceID in channelTracks) {
+        VTGapTrack *track = [channelTracks objectForKey:deviceID];
+        if ([track->held count] == 0) {
+            if (trackTimeout > 0 && now - track->lastArrival >= trackTimeout) {
+                expired = expired ?: [[NSMutableArray alloc] init];
+                [expired addObject:deviceID];
+            }
+            continue;
+        }
+        NSTimeInterval newest = ((VTNodeSample *)[track->held lastObject]).timestamp;
+        while ([track->held count] > 0) {
+            VTNodeSample *oldest = [track->held objectAtIndex:0];
+            if (oldest.timestamp > newest - reorderWindow && now - track->heldSince[0] < reorderWindow) {
+                break;
+            }
+            [self emitSample:[track popHeld] track:track channel:channel into:output];
+        }
+    }
+
+    // Devices that went away; their statistics are kept in the channel totals
+    for (NSString *deviceID in expired) {
+        [expiredStats[channel] addStats:((VTGapTrack *)[channelTracks objectForKey:deviceID])->stats];
+        [channelTracks removeObjectForKey:deviceID];
+    }
+
+    return output;
+}
+
+-(NSTimeInterval) stageHoldTimeForChannel:(VTSampleChannel)channel
+{
+    CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+    NSTimeInterval due = 0;
+    for (VTGapTrack *track in [tracks[channel] objectEnumerator]) {
+        CFAbsoluteTime when;
+        if ([track->held count]) {
+            when = track->heldSince[0] + reorderWindow;
+        }
+        else if (trackTimeout > 0) {
+            when = track->lastArrival + trackTimeout;
+        }
+        else {
+            continue;
+        }
+        // Never 0 while something is pending, so the hub still comes back for it
+        NSTimeInterval wait = MAX(when - now, 0.001);
+        if (due == 0 || wait < due) {
+            due = wait;
+        }
+    }
+    return due;
+}
+
+-(void) emitSample:(VTNodeSample *)sample track:(VTGapTrack *)track channel:(VTSampleChannel)channel into:(NSMutableArray *)output
+{
+    VTNodeSample *last = track->lastEmitted;
+    if (last) {
+        NSTimeInterval interval = sample.timestamp - last.timestamp;
+        BOOL learning = expectedPeriod[channel] == 0;
+        NSTimeInterval period = learning ? track->learnedPeriod : expectedPeriod[channel];
+        NSUInteger missing = 0;
+
+        if (period > 0) {
+            // Intervals are judged by how late the stream is running rather than one at a time: BLE
+            // delivers notifications in bursts, so a long interval next to short ones loses nothing.
+            // A stream running early is re-anchored rather than building up credit.
+            NSTimeInterval allowance = MAX((gapThreshold - 1.0) * period, 0.5 * deliveryJitter);
+            track->lateness = MAX(track->lateness + interval - period, -allowance);
+            if (track->lateness > allowance) {
+                missing = (NSUInteger)((track->lateness - allowance) / period) + 1;
+                track->lateness -= missing * period;
+                if (learning && [self relearnSlowerInterval:interval track:track]) {
+                    // The stream slowed down (e.g. it was reconfigured) rather than losing samples
+                    track->learnedPeriod = track->slowInterval;
+                    track->lateness = 0;
+                    track->learnSum = 0;
+                    track->learnCount = 0;
+                    [output addObject:sample];
+                    track->lastEmitted = sample;
+                    return;
+                }
+                track->stats.gaps++;
+                track->stats.missing += missing;
+                track->slowMissing += missing;
+                if (missing <= maxFillSamples) {
+                    [self fillFrom:last to:sample count:missing channel:channel into:output];
+                    track->stats.interpolated += missing;
+                }
+            }
+            else {
+                track->slowRun = 0;
+            }
+        }
+
+        if (learning) {
+            [self learnInterval:interval missing:missing track:track];
+        }
+    }
+
+    [output addObject:sample];
+    track->lastEmitted = sample;
+}
+
+// Learns the period from the mean interval over a window, counting samples found missing. Once
+// learned, a window only replaces it when the stream has clearly sped up; slow-downs are found by
+// relearnSlowerInterval:track:.
+-(void) learnInterval:(NSTimeInterval)interval missing:(NSUInteger)missing track:(VTGapTrack *)track
+{
+    track->learnSum += interval;
+    track->learnCount += 1 + missing;
+    if (track->learnCount < VT_GAP_LEARN_INTERVALS || track->learnSum < VT_GAP_LEARN_SECONDS) {
+        return;
+    }
+
+    NSTimeInterval mean = track->learnSum / track->learnCount;
+    if (track->learnedPeriod == 0 || mean < 0.75 * track->learnedPeriod) {
+        track->learnedPeriod = mean;
+        track->lateness = 0;
+    }
+    track->learnSum = 0;
+    track->learnCount = 0;
+}
+
+// Extends the run of consistent gaps. Once it is long enough, the gaps counted during it are taken
+// back and YES is returned; samples already interpolated for them have been passed on and stay.
+-(BOOL) relearnSlowerInterval:(NSTimeInterval)interval track:(VTGapTrack *)track
+{
+    if (track->slowRun && fabs(interval - track->slowInterval) <= 0.25 * track->slowInterval) {
+        track->slowRun++;
+        track->slowInterval += (interval - track->slowInterval) / track->slowRun;
+    }
+    else {
+        track->slowRun = 1;
+        track->slowInterval = interval;
+        track->slowMissing = 0;
+    }
+
+    if (track->slowRun < VT_GAP_RELEARN_RUN) {
+        return NO;
+    }
+    track->stats.gaps -= track->slowRun - 1;
+    track->stats.missing -= track->slowMissing;
+    track->slowRun = 0;
+    track->slowMissing = 0;
+    return YES;
+}
+
+-(void) fillFrom:(VTNodeSample *)from to:(VTNodeSample *)to count:(NSUInteger)count channel:(VTSampleChannel)channel into:(NSMutableArray *)output
+{
+    float a[4] = { 0 }, b[4] = { 0 }, v[4] = { 0 };
+    [from getValues:a];
+    [to getValues:b];
+    NSUInteger n = [VTNodeSample valueCountForChannel:channel];
+
+    for (NSUInteger k = 1; k <= count; k++) {
+        float t = (float)k / (float)(count + 1);
+        for (NSUInteger i = 0; i < n; i++) {
+            v[i] = a[i] + (b[i] - a[i]) * t;
+        }
+        if (channel == VTSampleChannelQuat) {
+            float norm = sqrtf(v[0] * v[0] + v[1] * v[1] + v[2] * v[2] + v[3] * v[3]);
+            if (norm > 0) {
+                for (NSUInteger i = 0; i < 4; i++) {
+                    v[i] /= norm;
+                }
+            }
+        }
+
+        NSTimeInterval timestamp = from.timestamp + (to.timestamp - from.timestamp) * t;
+        VTNodeSample *filled = [[VTNodeSample alloc] initWithDevice:to.device deviceID:to.deviceID channel:channel timestamp:timestamp flags:VTSampleFlagInterpolated values:v];
+        [output addObject:filled];
+    }
+}
+
+@end
@@ -0,0 +1,124 @@
+//
+//  VTTimeSeriesStore.h
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "VTNodeDeviceHub.h"
+#import "VTMemoryAccountant.h"
+
+/** The resolutions a VTTimeSeriesStore keeps, finest first */
+typedef enum {
+    VTRollupSecond = 0,
+    VTRollupMinute,
+    VTRollupHour,
+    VTRollupTierCount
+} VTRollupTier;
+
+////////////////////////////////////////////////////////////////////////////////
+/** Summary statistics of the values in a span of time */
+@interface VTSeriesSummary : NSObject
+/** Start of the span, in seconds since the reference date */
+@property (readonly, nonatomic) NSTimeInterval start;
+/** Length of the span in seconds */
+@property (readonly, nonatomic) NSTimeInterval duration;
+/** Number of values */
+@property (readonly, nonatomic) NSUInteger count;
+/** Smallest value (NAN if count is 0) */
+@property (readonly, nonatomic) float minimum;
+/** Largest value (NAN if count is 0) */
+@property (readonly, nonatomic) float maximum;
+/** Mean value (NAN if count is 0) */
+@property (readonly, nonatomic) double mean;
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+/** Keeps long histories of slow channels as fixed-size rollups instead of raw samples.
+
+ Every value is folded into a 1 second, a 1 minute and a 1 hour bucket (count, sum, min and max).
+ Closed buckets go into a ring per resolution, so each device and channel costs a fixed amount of
+ memory no matter how long it runs: by default one hour of seconds, one day of minutes and two weeks
+ of hours, at most about 170KB.
+
+ Range summaries are built from the coarsest buckets that fit wholly inside the range, refined at
+ the edges with finer buckets. Once finer buckets have been dropped from their ring, the edges are
+ covered by the enclosing coarse bucket instead, which may include a little data from outside the
+ range.
+
+ The store subscribes to the shared hub between start and stop; values can also be added directly
+ (e.g. when replaying a recording). Multi-value channels are tracked by their first value. While
+ started, the store is registered with the shared VTMemoryAccountant as "timeSeries". Use it from
+ the main thread.
+ */
+@interface VTTimeSeriesStore : NSObject <VTMemoryAccounting>
+
+/** The channels recorded from the hub (default the Clima, Therma and OXA channels). Set before start. */
+@property (nonatomic) uint32_t channels;
+/** Buckets kept for each tier (defaults 3600, 1440 and 336). Set before any value is added. */
+-(void) setCapacity:(NSUInteger)capacity forTier:(VTRollupTier)tier;
+/** Devices kept per channel, or 0 for no limit (default 8). When a new device would exceed it,
+ the history of the device heard from least recently is dropped. */
+@property (nonatomic) NSUInteger maxDevices;
+/** Bucket width of a tier in seconds */
++(NSTimeInterval) widthOfTier:(VTRollupTier)tier;
+/** Bytes of bucket storage currently allocated */
+@property (readonly, nonatomic) NSUInteger bytesUsed;
+
+/** Subscribes to the shared hub */
+-(void) start;
+/** Unsubscribes. Recorded history is kept. */
+-(void) stop;
+
+/** Records a value
+
+ @param value The value
+ @param timestamp When it was measured, in seconds since the reference date
+ @param deviceID The device identifier (see VTNodeSample deviceID)
+ @param channel The channel
+ */
+-(void) addValue:(float)value timestamp:(NSTimeInterval)timestamp deviceID:(NSString *)deviceID channel:(VTSampleChannel)channel;
+
+/** Summarizes a time range
+
+ @param deviceID The device identifier
+ @param channel The channel
+ @param from Start of the range (inclusive)
+ @param to End of the range (exclusive)
+ @return The summary, or nil if the device and channel have never been recorded
+ */
+-(VTSeriesSummary *) summaryForDeviceID:(NSString *)deviceID channel:(VTSampleChannel)channel from:(NSTimeInterval)from to:(NSTimeInterval)to;
+
+/** Returns the history of a time range as a series of buckets
+
+ The buckets come from the coarsest tier no wider than resolution whose history reaches back to
+ from. If no such tier still holds that history, the finest tier that does is used instead.
+
+ @param deviceID The device identifier
+ @param channel The channel
+ @param from Start of the range (inclusive)
+ @param to End of the range (exclusive)
+ @param resolution The widest acceptable bucket in seconds
+ @return VTSeriesSummary objects in time order, or nil if the device and channel have never been recorded
+ */
+-(NSArray *) seriesForDeviceID:(NSString *)deviceID channel:(VTSampleChannel)channel from:(NSTimeInterval)from to:(NSTimeInterval)to resolution:(NSTimeInterval)resolution;
+
+/** Discards all recorded history */
+-(void) reset;
+@end
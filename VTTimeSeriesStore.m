@@ -0,0 +1,459 @@
+//
+//  VTTimeSeriesStore.m
+//  NODE_API_DEMO
+//
+//  Created by Variable Technologies on 10/18/26.
+//  Copyright (c) 2026 Variable Technologies
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+//  associated documentation files (the "Software"), to deal in the Software without restriction, including
+//  without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+//  the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in all copies or substantial
+//  portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+//  LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN
+//  NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//  WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "VTTimeSeriesStore.h"
+#include <math.h>
+
+typedef struct {
+    double start;
+    double sum;
+    float minimum;
+    float maximum;
+    uint32_t count;
+} VTRollupBucket;
+
+// A ring of closed buckets plus the bucket currently being filled
+typedef struct {
+    double width;
+    NSUInteger capacity;
+    NSUInteger allocated;
+    NSUInteger head;
+    NSUInteger count;
+    VTRollupBucket *ring;
+    VTRollupBucket open;
+    BOOL hasOpen;
+} VTRollupRing;
+
+typedef struct {
+    NSUInteger count;
+    double sum;
+    float minimum;
+    float maximum;
+} VTRollupTotal;
+
+static const NSTimeInterval tierWidths[VTRollupTierCount] = { 1.0, 60.0, 3600.0 };
+
+#pragma mark - Rings
+// Buckets in time order: the closed ones, then the open one
+static NSUInteger VTRingLength(const VTRollupRing *r)
+{
+    return r->count + (r->hasOpen ? 1 : 0);
+}
+
+static const VTRollupBucket *VTRingBucket(const VTRollupRing *r, NSUInteger i)
+{
+    return i < r->count ? &r->ring[(r->head + i) % r->capacity] : &r->open;
+}
+
+// Index of the first bucket starting at or after t
+static NSUInteger VTRingLowerBound(const VTRollupRing *r, double t)
+{
+    NSUInteger lo = 0, hi = VTRingLength(r);
+    while (lo < hi) {
+        NSUInteger mid = (lo + hi) / 2;
+        if (VTRingBucket(r, mid)->start < t) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static double VTRingOldest(const VTRollupRing *r)
+{
+    return VTRingLength(r) ? VTRingBucket(r, 0)->start : INFINITY;
+}
+
+static void VTBucketAdd(VTRollupBucket *b, float value)
+{
+    b->sum += value;
+    b->minimum = b->count ? MIN(b->minimum, value) : value;
+    b->maximum = b->count ? MAX(b->maximum, value) : value;
+    b->count++;
+}
+
+static void VTRingClose(VTRollupRing *r)
+{
+    if (r->count == r->capacity) {
+        // Full: overwrite the oldest
+        r->head = (r->head + 1) % r->capacity;
+        r->count--;
+    }
+    else if (r->count == r->allocated) {
+        // Still growing, so the ring has not wrapped and can be reallocated in place
+        r->allocated = MIN(r->capacity, MAX(16, r->allocated * 2));
+        r->ring = realloc(r->ring, r->allocated * sizeof(VTRollupBucket));
+    }
+    r->ring[(r->head + r->count) % r->capacity] = r->open;
+    r->count++;
+}
+
+static void VTRingAdd(VTRollupRing *r, double t, float value)
+{
+    double start = floor(t / r->width) * r->width;
+
+    if (r->hasOpen && start < r->open.start) {
+        // Late value; fold it into its bucket if that is still held
+        NSUInteger i = VTRingLowerBound(r, start);
+        if (i < r->count && VTRingBucket(r, i)->start == start) {
+            VTBucketAdd(&r->ring[(r->head + i) % r->capacity], value);
+        }
+        return;
+    }
+    if (r->hasOpen && start > r->open.start) {
+        VTRingClose(r);
+        r->hasOpen = NO;
+    }
+    if (!r->hasOpen) {
+        memset(&r->open, 0, sizeof(r->open));
+        r->open.start = start;
+        r->hasOpen = YES;
+    }
+    VTBucketAdd(&r->open, value);
+}
+
+static void VTTotalAdd(VTRollupTotal *total, const VTRollupBucket *b)
+{
+    if (b->count == 0) {
+        return;
+    }
+    total->minimum = total->count ? MIN(total->minimum, b->minimum) : b->minimum;
+    total->maximum = total->count ? MAX(total->maximum, b->maximum) : b->maximum;
+    total->sum += b->sum;
+    total->count += b->count;
+}
+
+// Adds every bucket of r overlapping [from, to)
+static void VTRingTotalOverlapping(const VTRollupRing *r, double from, double to, VTRollupTotal *total)
+{
+    NSUInteger n = VTRingLength(r);
+    for (NSUInteger i = VTRingLowerBound(r, from - r->width + 1e-9); i < n; i++) {
+        const VTRollupBucket *b = VTRingBucket(r, i);
+        if (b->start >= to) {
+            break;
+        }
+        VTTotalAdd(total, b);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+@implementation VTSeriesSummary
+
+@synthesize start, duration, count, minimum, maximum, mean;
+
+-(id) initWithStart:(NSTimeInterval)aStart duration:(NSTimeInterval)aDuration total:(VTRollupTotal)total
+{
+    self = [super init];
+    if (self) {
+        start = aStart;
+        duration = aDuration;
+        count = total.count;
+        minimum = count ? total.minimum : NAN;
+        maximum = count ? total.maximum : NAN;
+        mean = count ? total.sum / count : NAN;
+    }
+    return self;
+}
+
+-(NSString *) description
+{
+    return [NSString stringWithFormat:@"<%@ %.0f+%.0fs n:%lu min:%.3f max:%.3f mean:%.3f>",
+            NSStringFromClass([self class]), start, duration, (unsigned long)count, minimum, maximum, mean];
+}
+
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+// The tiers of one device and channel
+@interface VTTimeSeries : NSObject
+{
+@public
+    VTRollupRing tiers[VTRollupTierCount];
+}
+-(id) initWithCapacities:(const NSUInteger *)capacities;
+@end
+
+@implementation VTTimeSeries
+
+-(id) initWithCapacities:(const NSUInteger *)capacities
+{
+    self = [super init];
+    if (self) {
+        for (int t = 0; t < VTRollupTierCount; t++) {
+            tiers[t].width = tierWidths[t];
+            tiers[t].capacity = MAX(capacities[t], 1);
+        }
+    }
+    return self;
+}
+
+-(void) dealloc
+{
+    for (int t = 0; t < VTRollupTierCount; t++) {
+        free(tiers[t].ring);
+    }
+}
+
+-(NSUInteger) bytesUsed
+{
+    NSUInteger bytes = 0;
+    for (int t = 0; t < VTRollupTierCount; t++) {
+        bytes += tiers[t].allocated * sizeof(VTRollupBucket);
+    }
+    return bytes;
+}
+
+// Totals [from, to) from tier t's whole buckets, refining the edges with finer tiers
+-(void) total:(VTRollupTotal *)total tier:(int)t from:(double)from to:(double)to
+{
+    if (from >= to) {
+        return;
+    }
+
+    VTRollupRing *r = &tiers[t];
+    double inner0 = ceil(from / r->width) * r->width;
+    double inner1 = floor(to / r->width) * r->width;
+
+    if (inner0 >= inner1) {
+        [self totalEdge:total tier:t from:from to:to];
+        return;
+    }
+
+    NSUInteger n = VTRingLength(r);
+    for (NSUInteger i = VTRingLowerBound(r, inner0); i < n; i++) {
+        const VTRollupBucket *b = VTRingBucket(r, i);
+        if (b->start >= inner1) {
+            break;
+        }
+        VTTotalAdd(total, b);
+    }
+    [self totalEdge:total tier:t from:from to:inner0];
+    [self totalEdge:total tier:t from:inner1 to:to];
+}
+
+// A range shorter than one of tier t's buckets
+-(void) totalEdge:(VTRollupTotal *)total tier:(int)t from:(double)from to:(double)to
+{
+    if (from >= to) {
+        return;
+    }
+
+    if (t > 0) {
+        VTRollupRing *finer = &tiers[t - 1];
+        if (VTRingOldest(finer) <= floor(from / finer->width) * finer->width) {
+            [self total:total tier:t - 1 from:from to:to];
+            return;
+        }
+    }
+    // No finer detail left; use the enclosing bucket
+    VTRingTotalOverlapping(&tiers[t], from, to, total);
+}
+
+@end
+
+////////////////////////////////////////////////////////////////////////////////
+@interface VTTimeSeriesStore ()
+{
+    NSUInteger capacities[VTRollupTierCount];
+    // deviceID -> VTTimeSeries, one dictionary per channel
+    NSMutableDictionary *series[VTSampleChannelCount];
+    VTHubSubscription *subscription;
+}
+@end
+
+@implementation VTTimeSeriesStore
+
+@synthesize channels;
+@synthesize maxDevices;
+
++(NSTimeInterval) widthOfTier:(VTRollupTier)tier
+{
+    return tierWidths[tier];
+}
+
+-(id) init
+{
+    self = [super init];
+    if (self) {
+        channels = VTSampleChannelMask(VTSampleChannelClimaTemp) | VTSampleChannelMask(VTSampleChannelClimaHumidity) |
+                   VTSampleChannelMask(VTSampleChannelClimaPressure) | VTSampleChannelMask(VTSampleChannelClimaLight) |
+                   VTSampleChannelMask(VTSampleChannelIRThermo) | VTSampleChannelMask(VTSampleChannelOxa) |
+                   VTSampleChannelMask(VTSampleChannelOxaTemp);
+        capacities[VTRollupSecond] = 3600;
+        capacities[VTRollupMinute] = 1440;
+        capacities[VTRollupHour] = 336;
+        maxDevices = 8;
+        [self reset];
+    }
+    return self;
+}
+
+-(void) dealloc
+{
+    if (subscription) {
+        [[VTNodeDeviceHub sharedInstance] unsubscribe:subscription];
+    }
+}
+
+-(void) setCapacity:(NSUInteger)capacity forTier:(VTRollupTier)tier
+{
+    capacities[tier] = MAX(capacity, 1);
+}
+
+-(NSUInteger) bytesUsed
+{
+    NSUInteger bytes = 0;
+    for (int ch = 0; ch < VTSampleChannelCount; ch++) {
+        for (VTTimeSeries *history in [series[ch] objectEnumerator]) {
+            bytes += [history bytesUsed];
+        }
+    }
+    return bytes;
+}
+
+-(NSUInteger) memoryBytesUsed
+{
+    return self.bytesUsed;
+}
+
+-(void) reset
+{
+    for (int ch = 0; ch < VTSampleChannelCount; ch++) {
+        series[ch] = [[NSMutableDictionary alloc] init];
+    }
+}
+
+-(void) start
+{
+    if (subscription) {
+        return;
+    }
+    __weak VTTimeSeriesStore *weakSelf = self;
+    subscription = [[VTNodeDeviceHub sharedInstance] subscribeToChannels:channels queue:NULL handler:^(VTSampleBatch *batch) {
+        VTTimeSeriesStore *store = weakSelf;
+        for (VTNodeSample *sample in batch.samples) {
+            [store addValue:sample.x timestamp:sample.timestamp deviceID:sample.deviceID channel:batch.channel];
+        }
+    }];
+    [[VTMemoryAccountant sharedInstance] registerSubsystem:self name:@"timeSeries"];
+}
+
+-(void) stop
+{
+    [[VTNodeDeviceHub sharedInstance] unsubscribe:subscription];
+    subscription = nil;
+    [[VTMemoryAccountant sharedInstance] unregisterSubsystem:self];
+}
+
+-(void) addValue:(float)value timestamp:(NSTimeInterval)timestamp deviceID:(NSString *)deviceID channel:(VTSampleChannel)channel
+{
+    if (isnan(value)) {
+        return;
+    }
+
+    VTTimeSeries *history = [series[channel] objectForKey:deviceID];
+    if (history == nil) {
+        if (maxDevices && [series[channel] count] >= maxDevices) {
+            [self evictStalestDeviceOfChannel:channel];
+        }
+        history = [[VTTimeSeries alloc] initWithCapacities:capacities];
+        [series[channel] setObject:history forKey:deviceID];
+    }
+    for (int t = 0; t < VTRollupTierCount; t++) {
+        VTRingAdd(&history->tiers[t], timestamp, value);
+    }
+}
+
+// Drops the history whose newest value is oldest
+-(void) evictStalestDeviceOfChannel:(VTSampleChannel)channel
+{
+    __block NSString *stalestID = nil;
+    __block double stalest = INFINITY;
+    [series[channel] enumerateKeysAndObjectsUsingBlock:^(NSString *deviceID, VTTimeSeries *history, BOOL *stop) {
+        double newest = history->tiers[VTRollupSecond].open.start;
+        if (newest < stalest) {
+            stalest = newest;
+            stalestID = deviceID;
+        }
+    }];
+    if (stalestID) {
+        [series[channel] removeObjectForKey:stalestID];
+    }
+}
+
+#pragma mark - Queries
+-(VTSeriesSummary *) summaryForDeviceID:(NSString *)deviceID channel:(VTSampleChannel)channel from:(NSTimeInterval)from to:(NSTimeInterval)to
+{
+    VTTimeSeries *history = [series[channel] objectForKey:deviceID];
+    if (history == nil) {
+        return nil;
+    }
+
+    VTRollupTotal total = { 0 };
+    [history total:&total tier:VTRollupTierCount - 1 from:from to:to];
+    return [[VTSeriesSummary alloc] initWithStart:from duration:MAX(0, to - from) total:total];
+}
+
+-(NSArray *) seriesForDeviceID:(NSString *)deviceID channel:(VTSampleChannel)channel from:(NSTimeInterval)from to:(NSTimeInterval)to resolution:(NSTimeInterval)resolution
+{
+    VTTimeSeries *history = [series[channel] objectForKey:deviceID];
+    if (history == nil) {
+        return nil;
+    }
+
+    // Coarsest tier within the resolution that still reaches back to from, else the finest that does
+    int chosen = -1;
+    for (int t = VTRollupTierCount - 1; t >= 0 && chosen < 0; t--) {
+        VTRollupRing *r = &history->tiers[t];
+        if (r->width <= resolution && VTRingOldest(r) <= floor(from / r->width) * r->width) {
+            chosen = t;
+        }
+    }
+    for (int t = 0; t < VTRollupTierCount && chosen < 0; t++) {
+        VTRollupRing *r = &history->tiers[t];
+        if (VTRingOldest(r) <= floor(from / r->width) * r->width) {
+            chosen = t;
+        }
+    }
+    if (chosen < 0) {
+        // Nothing reaches back that far; return what the coarsest tier has
+        chosen = VTRollupTierCount - 1;
+    }
+
+    VTRollupRing *r = &history->tiers[chosen];
+    NSMutableArray *buckets = [[NSMutableArray alloc] init];
+    NSUInteger n = VTRingLength(r);
+    for (NSUInteger i = VTRingLowerBound(r, from - r->width + 1e-9); i < n; i++) {
+        const VTRollupBucket *b = VTRingBucket(r, i);
+        if (b->start >= to) {
+            break;
+        }
+        VTRollupTotal total = { 0 };
+        VTTotalAdd(&total, b);
+        [buckets addObject:[[VTSeriesSummary alloc] initWithStart:b->start duration:r->width total:total]];
+    }
+    return buckets;
+}
+
+@end